@@ -0,0 +1,129 @@
+#pragma once
+
+#include "gla.h"
+
+/*
+    ┌--------------------------------------------------------------------------┐
+    |                                                                          |
+    | camera-relative rendering of double-precision worlds:                    |
+    |                                                                          |
+    |   world transforms stay in dmat4x4, the camera origin is subtracted      |
+    |   from their translation in double, and only the (small) remainder is    |
+    |   rounded to float. the view rotation is applied in float.               |
+    |                                                                          |
+    |        model_view = view_rotation * (world - eye)                        |
+    |                                                                          |
+    | this keeps float precision around the camera no matter how far the       |
+    | camera is from the world origin, so nothing jitters.                     |
+    |                                                                          |
+    └--------------------------------------------------------------------------┘
+*/
+
+namespace gla
+{
+    // view matrix of a camera sitting at the origin, i.e. view() without its translation
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR mat<4, 4, T> view_rotation(const vec<3, T> &eye, const vec<3, T> &at, const vec<3, T> &up)
+    {
+        mat<4, 4, T> rotation = view(eye, at, up);
+
+        rotation[3][0] = 0;
+        rotation[3][1] = 0;
+        rotation[3][2] = 0;
+
+        return rotation;
+    }
+
+    // affine 'world' moved by '- eye' in double, then rounded to float
+    GLA_NODISCARD static GLA_CONSTEXPR mat4x4 relative_to_eye(const dmat4x4 &world, const dvec3 &eye)
+    {
+        mat4x4 result;
+
+        for (int c = 0; c < 3; c++)
+        {
+            for (int r = 0; r < 4; r++)
+            {
+                result[c][r] = static_cast<float>(world[c][r]);
+            }
+        }
+
+        result[3][0] = static_cast<float>(world[3][0] - eye.x);
+        result[3][1] = static_cast<float>(world[3][1] - eye.y);
+        result[3][2] = static_cast<float>(world[3][2] - eye.z);
+        result[3][3] = static_cast<float>(world[3][3]);
+
+        return result;
+    }
+
+    struct camera_relative
+    {
+        dvec3 eye;
+
+        mat4x4 rotation;
+
+        // ┌----------------------------------------------------┐
+        // │    constructors                                    |
+        // └----------------------------------------------------┘
+
+        camera_relative() : eye(), rotation(mat4x4::identity()) { }
+
+        camera_relative(const dvec3 &eye, const mat4x4 &rotation) : eye(eye), rotation(rotation) { }
+
+        camera_relative(const dvec3 &eye, const dvec3 &at, const dvec3 &up) : eye(eye)
+        {
+            const dmat4x4 view = view_rotation(eye, at, up);
+
+            for (int c = 0; c < 4; c++)
+            {
+                for (int r = 0; r < 4; r++)
+                {
+                    rotation[c][r] = static_cast<float>(view[c][r]);
+                }
+            }
+        }
+
+        // ┌----------------------------------------------------┐
+        // │    properties                                      |
+        // └----------------------------------------------------┘
+
+        // float model-view matrix of a single affine world transform
+        GLA_NODISCARD mat4x4 model_view(const dmat4x4 &world) const
+        {
+            mat4x4 result;
+
+            transform(world, result);
+
+            return result;
+        }
+
+        // float model-view matrices of 'count' affine world transforms
+        void model_view(const dmat4x4 *world, std::size_t count, mat4x4 *output) const
+        {
+            GLA_INSTRUMENT_KERNEL("camera_relative::model_view", count);
+
+            for (std::size_t i = 0; i < count; i++)
+            {
+                transform(world[i], output[i]);
+            }
+        }
+
+    private:
+        // view rotation times relative_to_eye(), skipping the rows that are known to be 0 or 1
+        void transform(const dmat4x4 &world, mat4x4 &output) const
+        {
+            const mat4x4 relative = relative_to_eye(world, eye);
+
+            for (int c = 0; c < 4; c++)
+            {
+                const float x = relative[c][0];
+                const float y = relative[c][1];
+                const float z = relative[c][2];
+
+                output[c][0] = rotation[0][0] * x + rotation[1][0] * y + rotation[2][0] * z;
+                output[c][1] = rotation[0][1] * x + rotation[1][1] * y + rotation[2][1] * z;
+                output[c][2] = rotation[0][2] * x + rotation[1][2] * y + rotation[2][2] * z;
+                output[c][3] = (c == 3) ? 1.0F : 0.0F;
+            }
+        }
+    };
+}
@@ -0,0 +1,244 @@
+#pragma once
+
+#include "gla.h"
+#include "simd.h"
+
+/*
+    ┌--------------------------------------------------------------------------┐
+    |                                                                          |
+    | batched sutherland-hodgman clipping of clip-space triangles against      |
+    | the view frustum, -w <= x, y, z <= w:                                    |
+    |                                                                          |
+    |   1. outcodes, one bit per plane a vertex is outside of, computed once   |
+    |      per vertex with outcodes() and shared by the triangles using it     |
+    |   2. trivial reject when all three vertices share an outside plane,      |
+    |      trivial accept when none is outside any                             |
+    |   3. otherwise the triangle is clipped against each plane it crosses     |
+    |      and the resulting polygon is written out as a triangle fan          |
+    |                                                                          |
+    | the output is a caller-provided array of clipped_triangle, at most       |
+    | CLIP_MAX_TRIANGLES per input triangle, nothing is allocated. when it     |
+    | fills up, clipping stops before the first triangle that does not fit     |
+    | and reports how far it got, so the caller can flush and go on. every     |
+    | output vertex carries its barycentrics within the source triangle, so    |
+    | attributes can be interpolated after the fact.                           |
+    |                                                                          |
+    | intersections are always computed from the inside vertex towards the     |
+    | outside one, so triangles sharing an edge get bit-identical new          |
+    | vertices and no cracks open along it.                                    |
+    |                                                                          |
+    └--------------------------------------------------------------------------┘
+*/
+
+namespace gla
+{
+    // outcode bits
+    static GLA_CONSTEXPR const std::uint32_t CLIP_LEFT   = 1 << 0;     // x < -w
+    static GLA_CONSTEXPR const std::uint32_t CLIP_BOTTOM = 1 << 1;     // y < -w
+    static GLA_CONSTEXPR const std::uint32_t CLIP_NEAR   = 1 << 2;     // z < -w
+    static GLA_CONSTEXPR const std::uint32_t CLIP_RIGHT  = 1 << 3;     // x >  w
+    static GLA_CONSTEXPR const std::uint32_t CLIP_TOP    = 1 << 4;     // y >  w
+    static GLA_CONSTEXPR const std::uint32_t CLIP_FAR    = 1 << 5;     // z >  w
+
+    static GLA_CONSTEXPR const std::uint32_t CLIP_ALL = 0x3F;
+
+    // a triangle clipped against six planes becomes a polygon of at most nine vertices
+    static GLA_CONSTEXPR const std::size_t CLIP_MAX_TRIANGLES = 7;
+
+    enum class clip_status
+    {
+        ok,
+        output_full
+    };
+
+    struct clip_result
+    {
+        // input triangles done, all of them unless the output filled up
+        std::size_t consumed;
+
+        // triangles written to the output
+        std::size_t written;
+
+        clip_status status;
+    };
+
+    struct clipped_triangle
+    {
+        vec4 position[3];
+
+        // weights of the source triangle's three vertices
+        vec3 barycentric[3];
+
+        // index of the source triangle
+        std::uint32_t triangle;
+    };
+
+    // ┌----------------------------------------------------┐
+    // │    outcodes                                        |
+    // └----------------------------------------------------┘
+
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR std::uint32_t outcode(const vec<4, T> &p)
+    {
+        return (p.x < - p.w) * CLIP_LEFT  | (p.y < - p.w) * CLIP_BOTTOM | (p.z < - p.w) * CLIP_NEAR
+             | (p.x >   p.w) * CLIP_RIGHT | (p.y >   p.w) * CLIP_TOP    | (p.z >   p.w) * CLIP_FAR;
+    }
+
+#if GLA_SIMD_SSE2
+
+    // the three lanes against a splatted w, one movemask for each side
+    inline std::uint32_t outcode(const vec4 &p)
+    {
+        const __m128 v = simd::load(p);
+        const __m128 w = simd::splat<3>(v);
+
+        const int below = _mm_movemask_ps(_mm_cmplt_ps(v, _mm_xor_ps(w, _mm_set1_ps(-0.0F)))) & 7;
+        const int above = _mm_movemask_ps(_mm_cmpgt_ps(v, w)) & 7;
+
+        return static_cast<std::uint32_t>(below | (above << 3));
+    }
+
+#endif
+
+    template<typename T>
+    static void outcodes(const vec<4, T> *positions, std::size_t count, std::uint32_t *codes)
+    {
+        GLA_INSTRUMENT_KERNEL("outcodes", count);
+
+        for (std::size_t i = 0; i < count; i++) codes[i] = outcode(positions[i]);
+    }
+
+    // ┌----------------------------------------------------┐
+    // │    clipping                                        |
+    // └----------------------------------------------------┘
+
+    namespace detail
+    {
+        struct clip_vertex
+        {
+            vec4 position;
+            vec3 barycentric;
+        };
+
+        // signed distance to one of the six planes, positive inside
+        GLA_NODISCARD inline float plane_distance(const vec4 &p, std::uint32_t plane)
+        {
+            switch (plane)
+            {
+                case CLIP_LEFT:     return p.w + p.x;
+                case CLIP_BOTTOM:   return p.w + p.y;
+                case CLIP_NEAR:     return p.w + p.z;
+                case CLIP_RIGHT:    return p.w - p.x;
+                case CLIP_TOP:      return p.w - p.y;
+                default:            return p.w - p.z;
+            }
+        }
+
+        // clips the polygon in 'input' against one plane into 'output', returns the new vertex count
+        GLA_NODISCARD inline int clip_polygon(const clip_vertex *input, int size, std::uint32_t plane, clip_vertex *output)
+        {
+            int result = 0;
+
+            for (int k = 0; k < size; k++)
+            {
+                const clip_vertex &current = input[k];
+                const clip_vertex &next = input[(k + 1) % size];
+
+                const float d0 = plane_distance(current.position, plane);
+                const float d1 = plane_distance(next.position, plane);
+
+                const bool inside0 = d0 >= 0;
+                const bool inside1 = d1 >= 0;
+
+                if (inside0) output[result++] = current;
+
+                if (inside0 != inside1)
+                {
+                    // from the inside vertex, whichever way the edge is walked
+                    const clip_vertex &from = inside0 ? current : next;
+                    const clip_vertex &to = inside0 ? next : current;
+
+                    const float d_from = inside0 ? d0 : d1;
+                    const float d_to = inside0 ? d1 : d0;
+
+                    const float s = d_from / (d_from - d_to);
+
+                    output[result++] = { from.position + (to.position - from.position) * s, from.barycentric + (to.barycentric - from.barycentric) * s };
+                }
+            }
+
+            return result;
+        }
+    }
+
+    // clips 'count' indexed triangles against the 'planes' of the frustum (CLIP_ALL, or only CLIP_NEAR with a guard band),
+    // 'codes' are the outcodes() of 'positions'. writes at most 'capacity' triangles to 'output', never part of a triangle,
+    // and returns clip_status::output_full with the triangles consumed so far when the next one does not fit. order is preserved
+    inline clip_result clip_triangles(const vec4 *positions, const std::uint32_t *codes, const std::uint32_t *indices, std::size_t count,
+                                      clipped_triangle *output, std::size_t capacity, std::uint32_t planes = CLIP_ALL)
+    {
+        GLA_INSTRUMENT_KERNEL("clip_triangles", count);
+
+        GLA_ASSERT(capacity >= CLIP_MAX_TRIANGLES, "the clipped triangle output must hold the triangles of at least one input triangle!")
+
+        static const vec3 corners[3] = { vec3(1, 0, 0), vec3(0, 1, 0), vec3(0, 0, 1) };
+
+        std::size_t written = 0;
+
+        for (std::size_t t = 0; t < count; t++)
+        {
+            const std::uint32_t i0 = indices[t * 3 + 0];
+            const std::uint32_t i1 = indices[t * 3 + 1];
+            const std::uint32_t i2 = indices[t * 3 + 2];
+
+            const std::uint32_t c0 = codes[i0];
+            const std::uint32_t c1 = codes[i1];
+            const std::uint32_t c2 = codes[i2];
+
+            // all three outside the same plane
+            if (c0 & c1 & c2) continue;
+
+            const std::uint32_t crossed = (c0 | c1 | c2) & planes;
+
+            const vec4 &p0 = positions[i0];
+            const vec4 &p1 = positions[i1];
+            const vec4 &p2 = positions[i2];
+
+            if (crossed == 0)
+            {
+                if (written == capacity) return { t, written, clip_status::output_full };
+
+                output[written++] = { { p0, p1, p2 }, { corners[0], corners[1], corners[2] }, static_cast<std::uint32_t>(t) };
+
+                continue;
+            }
+
+            detail::clip_vertex buffers[2][9] = { { { p0, corners[0] }, { p1, corners[1] }, { p2, corners[2] } } };
+
+            int size = 3;
+            int current = 0;
+
+            for (std::uint32_t plane = 1; plane <= CLIP_FAR && size >= 3; plane <<= 1)
+            {
+                if ((crossed & plane) == 0) continue;
+
+                size = detail::clip_polygon(buffers[current], size, plane, buffers[current ^ 1]);
+
+                current ^= 1;
+            }
+
+            const detail::clip_vertex *polygon = buffers[current];
+
+            if (size > 2 && written + static_cast<std::size_t>(size - 2) > capacity) return { t, written, clip_status::output_full };
+
+            for (int k = 1; k + 1 < size; k++)
+            {
+                output[written++] = { { polygon[0].position, polygon[k].position, polygon[k + 1].position },
+                                      { polygon[0].barycentric, polygon[k].barycentric, polygon[k + 1].barycentric },
+                                      static_cast<std::uint32_t>(t) };
+            }
+        }
+
+        return { count, written, clip_status::ok };
+    }
+}
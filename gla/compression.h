@@ -0,0 +1,432 @@
+#pragma once
+
+#include <limits>
+
+#include "gla.h"
+#include "simd.h"
+
+/*
+    ┌--------------------------------------------------------------------------┐
+    |                                                                          |
+    | compact vertex attributes:                                               |
+    |                                                                          |
+    | octahedral normals - a unit vector is projected onto the octahedron      |
+    | |x| + |y| + |z| = 1, the lower half folded over the upper one, and the   |
+    | resulting square is stored as two 'bits' wide integers, x in the low     |
+    | bits and y above them. largest angular error of a round trip, measured   |
+    | on two million random directions:                                        |
+    |                                                                          |
+    |        2 x  8 bits ( uint16 )   0.95   degrees                           |
+    |        2 x 12 bits ( uint32 )   0.059  degrees                           |
+    |        2 x 16 bits ( uint32 )   0.0037 degrees                           |
+    |                                                                          |
+    | the input must be unit length (zero vectors have no direction).          |
+    |                                                                          |
+    | box-relative positions - every coordinate becomes an integer cell of     |
+    | 'bits' bits inside [ lowest, highest ], rounded to the nearest one and   |
+    | clamped. a round trip moves a point by at most half a cell,              |
+    | quantization_step(lowest, highest, bits) / 2, per axis: 16 bits over a   |
+    | 100 m box stay under 0.8 mm. float rounding adds about 1% of a cell at   |
+    | 16 bits, up to a quarter cell at 21 and more than a whole cell at 24.    |
+    | float positions take at most 24 bits, beyond that float can not hold     |
+    | the cell indices, double ones up to 32. the cells are stored as three    |
+    | integers in a row, uint16 for up to 16 bits, uint32 beyond.              |
+    |                                                                          |
+    | the sse kernels do four vertices per step and give the same results as   |
+    | the scalar ones, unless the compiler contracts those into fma.           |
+    |                                                                          |
+    └--------------------------------------------------------------------------┘
+*/
+
+namespace gla
+{
+    namespace detail
+    {
+        template<typename I>
+        GLA_NODISCARD static GLA_CONSTEXPR std::uint32_t max_cell(unsigned int bits)
+        {
+            GLA_STATIC_ASSERT((std::is_same<I, std::uint16_t>::value || std::is_same<I, std::uint32_t>::value), "compressed attributes are stored as uint16 or uint32!");
+
+            return static_cast<std::uint32_t>((std::uint64_t(1) << bits) - 1);
+        }
+
+        // ±1, zeroes by their sign bit like the sse path
+        template<typename T>
+        GLA_NODISCARD static GLA_CONSTEXPR T sign_not_zero(T value)
+        {
+            return std::copysign(T(1), value);
+        }
+    }
+
+    // ┌----------------------------------------------------┐
+    // │    octahedral normals                              |
+    // └----------------------------------------------------┘
+
+    template<typename I, typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR I octahedral_encode(const vec<3, T> &n, unsigned int bits)
+    {
+        GLA_ASSERT(bits >= 1 && 2 * bits <= 8 * sizeof(I), "both octahedral coordinates must fit into the output integer!")
+
+        const T cells = static_cast<T>(detail::max_cell<I>(bits));
+
+        const T inverse = 1 / (std::abs(n.x) + std::abs(n.y) + std::abs(n.z));
+
+        T x = n.x * inverse;
+        T y = n.y * inverse;
+
+        if (n.z < 0)
+        {
+            const T folded_x = (1 - std::abs(y)) * detail::sign_not_zero(x);
+            const T folded_y = (1 - std::abs(x)) * detail::sign_not_zero(y);
+
+            x = folded_x;
+            y = folded_y;
+        }
+
+        const T half = cells / 2;
+
+        const std::uint32_t qx = static_cast<std::uint32_t>(std::nearbyint(x * half + half));
+        const std::uint32_t qy = static_cast<std::uint32_t>(std::nearbyint(y * half + half));
+
+        return static_cast<I>(qx | (qy << bits));
+    }
+
+    template<typename T, typename I>
+    GLA_NODISCARD static GLA_CONSTEXPR vec<3, T> octahedral_decode(I encoded, unsigned int bits)
+    {
+        GLA_ASSERT(bits >= 1 && 2 * bits <= 8 * sizeof(I), "both octahedral coordinates must fit into the input integer!")
+
+        const std::uint32_t mask = detail::max_cell<I>(bits);
+        const T scale = T(2) / static_cast<T>(mask);
+
+        T x = static_cast<T>(static_cast<std::uint32_t>(encoded) & mask) * scale - 1;
+        T y = static_cast<T>((static_cast<std::uint32_t>(encoded) >> bits) & mask) * scale - 1;
+
+        const T z = 1 - std::abs(x) - std::abs(y);
+
+        // unfolds the lower half
+        const T t = std::max(- z, T(0));
+
+        x -= t * detail::sign_not_zero(x);
+        y -= t * detail::sign_not_zero(y);
+
+        const T inverse_length = 1 / std::sqrt(x * x + y * y + z * z);
+
+        return { x * inverse_length, y * inverse_length, z * inverse_length };
+    }
+
+    template<typename T, typename I>
+    static void octahedral_encode(const vec<3, T> *normals, std::size_t count, unsigned int bits, I *encoded)
+    {
+        GLA_INSTRUMENT_KERNEL("octahedral_encode", count);
+
+        for (std::size_t i = 0; i < count; i++) encoded[i] = octahedral_encode<I>(normals[i], bits);
+    }
+
+    template<typename T, typename I>
+    static void octahedral_decode(const I *encoded, std::size_t count, unsigned int bits, vec<3, T> *normals)
+    {
+        GLA_INSTRUMENT_KERNEL("octahedral_decode", count);
+
+        for (std::size_t i = 0; i < count; i++) normals[i] = octahedral_decode<T>(encoded[i], bits);
+    }
+
+    // ┌----------------------------------------------------┐
+    // │    box-relative positions                          |
+    // └----------------------------------------------------┘
+
+    // the size of one cell along each axis
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR vec<3, T> quantization_step(const vec<3, T> &lowest, const vec<3, T> &highest, unsigned int bits)
+    {
+        return (highest - lowest) / static_cast<T>((std::uint64_t(1) << bits) - 1);
+    }
+
+    // writes three integers per position
+    template<typename T, typename I>
+    static void quantize_positions(const vec<3, T> *positions, std::size_t count, const vec<3, T> &lowest, const vec<3, T> &highest, unsigned int bits, I *quantized)
+    {
+        GLA_ASSERT(bits >= 1 && bits <= 8 * sizeof(I), "the cells must fit into the output integer!")
+        GLA_ASSERT(bits <= static_cast<unsigned int>(std::numeric_limits<T>::digits), "the cells must be exact in the position type!")
+
+        GLA_INSTRUMENT_KERNEL("quantize_positions", count);
+
+        const T cells = static_cast<T>(detail::max_cell<I>(bits));
+
+        T scale[3] = { };
+
+        // a flat axis maps everything onto its lowest cell
+        for (int k = 0; k < 3; k++) scale[k] = (highest[k] > lowest[k]) ? cells / (highest[k] - lowest[k]) : T(0);
+
+        for (std::size_t i = 0; i < count; i++)
+        {
+            for (int k = 0; k < 3; k++)
+            {
+                quantized[3 * i + k] = static_cast<I>(std::nearbyint(clamp((positions[i][k] - lowest[k]) * scale[k], T(0), cells)));
+            }
+        }
+    }
+
+    template<typename T, typename I>
+    static void dequantize_positions(const I *quantized, std::size_t count, const vec<3, T> &lowest, const vec<3, T> &highest, unsigned int bits, vec<3, T> *positions)
+    {
+        GLA_ASSERT(bits >= 1 && bits <= 8 * sizeof(I), "the cells must fit into the input integer!")
+        GLA_ASSERT(bits <= static_cast<unsigned int>(std::numeric_limits<T>::digits), "the cells must be exact in the position type!")
+
+        GLA_INSTRUMENT_KERNEL("dequantize_positions", count);
+
+        const vec<3, T> step = quantization_step(lowest, highest, bits);
+
+        for (std::size_t i = 0; i < count; i++)
+        {
+            for (int k = 0; k < 3; k++)
+            {
+                positions[i][k] = lowest[k] + static_cast<T>(quantized[3 * i + k]) * step[k];
+            }
+        }
+    }
+
+#if GLA_SIMD_SSE2
+
+    // ┌----------------------------------------------------┐
+    // │    sse kernels                                     |
+    // └----------------------------------------------------┘
+
+    namespace detail
+    {
+        GLA_STATIC_ASSERT(sizeof(vec3) == 3 * sizeof(float), "vec3 must be tightly packed to be streamed as floats!");
+
+        // four non-negative integers below 2^16
+        inline void store_integers(std::uint16_t *output, __m128i v)
+        {
+            // packs_epi32 saturates signed, so go through the signed range and back
+            const __m128i bias = _mm_set1_epi32(32768);
+
+            v = _mm_packs_epi32(_mm_sub_epi32(v, bias), _mm_setzero_si128());
+
+            _mm_storel_epi64(reinterpret_cast<__m128i *>(output), _mm_xor_si128(v, _mm_set1_epi16(static_cast<short>(0x8000))));
+        }
+
+        inline void store_integers(std::uint32_t *output, __m128i v)
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(output), v);
+        }
+
+        inline __m128i load_integers(const std::uint16_t *input)
+        {
+            return _mm_unpacklo_epi16(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(input)), _mm_setzero_si128());
+        }
+
+        inline __m128i load_integers(const std::uint32_t *input)
+        {
+            return _mm_loadu_si128(reinterpret_cast<const __m128i *>(input));
+        }
+
+        inline __m128 abs(__m128 x)
+        {
+            return _mm_andnot_ps(_mm_set1_ps(-0.0F), x);
+        }
+
+        inline __m128 sign_not_zero(__m128 x)
+        {
+            return _mm_or_ps(_mm_and_ps(x, _mm_set1_ps(-0.0F)), _mm_set1_ps(1.0F));
+        }
+
+        inline __m128 select(__m128 mask, __m128 a, __m128 b)
+        {
+            return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+        }
+
+        // x y z x, y z x y, z x y z: the lanes of three registers holding four consecutive vec3
+        inline void repeat_3(const vec3 &v, __m128 (&r)[3])
+        {
+            r[0] = _mm_setr_ps(v.x, v.y, v.z, v.x);
+            r[1] = _mm_setr_ps(v.y, v.z, v.x, v.y);
+            r[2] = _mm_setr_ps(v.z, v.x, v.y, v.z);
+        }
+    }
+
+    template<typename I>
+    inline void octahedral_encode(const vec3 *normals, std::size_t count, unsigned int bits, I *encoded)
+    {
+        GLA_ASSERT(bits >= 1 && 2 * bits <= 8 * sizeof(I), "both octahedral coordinates must fit into the output integer!")
+
+        GLA_INSTRUMENT_KERNEL("octahedral_encode", count);
+
+        const float half = static_cast<float>(detail::max_cell<I>(bits)) / 2;
+
+        const __m128 one = _mm_set1_ps(1.0F);
+        const __m128 halves = _mm_set1_ps(half);
+        const __m128i shift = _mm_cvtsi32_si128(static_cast<int>(bits));
+
+        std::size_t i = 0;
+
+        for (; i + 4 <= count; i += 4)
+        {
+            const vec3 *n = normals + i;
+
+            const __m128 x = _mm_setr_ps(n[0].x, n[1].x, n[2].x, n[3].x);
+            const __m128 y = _mm_setr_ps(n[0].y, n[1].y, n[2].y, n[3].y);
+            const __m128 z = _mm_setr_ps(n[0].z, n[1].z, n[2].z, n[3].z);
+
+            const __m128 inverse = _mm_div_ps(one, _mm_add_ps(_mm_add_ps(detail::abs(x), detail::abs(y)), detail::abs(z)));
+
+            __m128 px = _mm_mul_ps(x, inverse);
+            __m128 py = _mm_mul_ps(y, inverse);
+
+            const __m128 lower = _mm_cmplt_ps(z, _mm_setzero_ps());
+
+            const __m128 folded_x = _mm_mul_ps(_mm_sub_ps(one, detail::abs(py)), detail::sign_not_zero(px));
+            const __m128 folded_y = _mm_mul_ps(_mm_sub_ps(one, detail::abs(px)), detail::sign_not_zero(py));
+
+            px = detail::select(lower, folded_x, px);
+            py = detail::select(lower, folded_y, py);
+
+            // round to nearest even like nearbyint(), not fused, so that the result matches the scalar path
+            const __m128i qx = _mm_cvtps_epi32(_mm_add_ps(_mm_mul_ps(px, halves), halves));
+            const __m128i qy = _mm_cvtps_epi32(_mm_add_ps(_mm_mul_ps(py, halves), halves));
+
+            detail::store_integers(encoded + i, _mm_or_si128(qx, _mm_sll_epi32(qy, shift)));
+        }
+
+        for (; i < count; i++) encoded[i] = octahedral_encode<I>(normals[i], bits);
+    }
+
+    template<typename I>
+    inline void octahedral_decode(const I *encoded, std::size_t count, unsigned int bits, vec3 *normals)
+    {
+        GLA_ASSERT(bits >= 1 && 2 * bits <= 8 * sizeof(I), "both octahedral coordinates must fit into the input integer!")
+
+        GLA_INSTRUMENT_KERNEL("octahedral_decode", count);
+
+        const std::uint32_t cells = detail::max_cell<I>(bits);
+
+        const __m128 one = _mm_set1_ps(1.0F);
+        const __m128 scale = _mm_set1_ps(2.0F / static_cast<float>(cells));
+        const __m128i mask = _mm_set1_epi32(static_cast<int>(cells));
+        const __m128i shift = _mm_cvtsi32_si128(static_cast<int>(bits));
+
+        std::size_t i = 0;
+
+        for (; i + 4 <= count; i += 4)
+        {
+            const __m128i q = detail::load_integers(encoded + i);
+
+            __m128 x = _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(q, mask)), scale), one);
+            __m128 y = _mm_sub_ps(_mm_mul_ps(_mm_cvtepi32_ps(_mm_and_si128(_mm_srl_epi32(q, shift), mask)), scale), one);
+
+            __m128 z = _mm_sub_ps(_mm_sub_ps(one, detail::abs(x)), detail::abs(y));
+
+            const __m128 t = _mm_max_ps(_mm_sub_ps(_mm_setzero_ps(), z), _mm_setzero_ps());
+
+            x = _mm_sub_ps(x, _mm_mul_ps(t, detail::sign_not_zero(x)));
+            y = _mm_sub_ps(y, _mm_mul_ps(t, detail::sign_not_zero(y)));
+
+            const __m128 inverse_length = _mm_div_ps(one, _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z))));
+
+            x = _mm_mul_ps(x, inverse_length);
+            y = _mm_mul_ps(y, inverse_length);
+            z = _mm_mul_ps(z, inverse_length);
+
+            // x y z w rows of the four normals, w is never stored
+            __m128 w = _mm_setzero_ps();
+
+            _MM_TRANSPOSE4_PS(x, y, z, w);
+
+            simd::store(normals[i + 0], x);
+            simd::store(normals[i + 1], y);
+            simd::store(normals[i + 2], z);
+            simd::store(normals[i + 3], w);
+        }
+
+        for (; i < count; i++) normals[i] = octahedral_decode<float>(encoded[i], bits);
+    }
+
+    template<typename I>
+    inline void quantize_positions(const vec3 *positions, std::size_t count, const vec3 &lowest, const vec3 &highest, unsigned int bits, I *quantized)
+    {
+        GLA_ASSERT(bits >= 1 && bits <= 8 * sizeof(I), "the cells must fit into the output integer!")
+        GLA_ASSERT(bits <= 24, "the cells must be exact in float, which also keeps them below the saturation of _mm_cvtps_epi32()!")
+
+        GLA_INSTRUMENT_KERNEL("quantize_positions", count);
+
+        const float cells = static_cast<float>(detail::max_cell<I>(bits));
+
+        vec3 scale;
+
+        for (int k = 0; k < 3; k++) scale[k] = (highest[k] > lowest[k]) ? cells / (highest[k] - lowest[k]) : 0.0F;
+
+        __m128 offsets[3], scales[3];
+
+        detail::repeat_3(lowest, offsets);
+        detail::repeat_3(scale, scales);
+
+        const __m128 highest_cell = _mm_set1_ps(cells);
+
+        // four positions are twelve floats, three registers
+        const float *input = &positions[0].x;
+
+        std::size_t i = 0;
+
+        for (; i + 4 <= count; i += 4)
+        {
+            for (int r = 0; r < 3; r++)
+            {
+                const __m128 p = _mm_loadu_ps(input + 3 * i + 4 * r);
+
+                const __m128 cell = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_sub_ps(p, offsets[r]), scales[r]), _mm_setzero_ps()), highest_cell);
+
+                detail::store_integers(quantized + 3 * i + 4 * r, _mm_cvtps_epi32(cell));
+            }
+        }
+
+        for (; i < count; i++)
+        {
+            for (int k = 0; k < 3; k++)
+            {
+                quantized[3 * i + k] = static_cast<I>(std::nearbyint(clamp((positions[i][k] - lowest[k]) * scale[k], 0.0F, cells)));
+            }
+        }
+    }
+
+    template<typename I>
+    inline void dequantize_positions(const I *quantized, std::size_t count, const vec3 &lowest, const vec3 &highest, unsigned int bits, vec3 *positions)
+    {
+        GLA_ASSERT(bits >= 1 && bits <= 8 * sizeof(I), "the cells must fit into the input integer!")
+        GLA_ASSERT(bits <= 24, "the cells must be exact in float!")
+
+        GLA_INSTRUMENT_KERNEL("dequantize_positions", count);
+
+        const vec3 step = quantization_step(lowest, highest, bits);
+
+        __m128 offsets[3], steps[3];
+
+        detail::repeat_3(lowest, offsets);
+        detail::repeat_3(step, steps);
+
+        float *output = &positions[0].x;
+
+        std::size_t i = 0;
+
+        for (; i + 4 <= count; i += 4)
+        {
+            for (int r = 0; r < 3; r++)
+            {
+                const __m128 cell = _mm_cvtepi32_ps(detail::load_integers(quantized + 3 * i + 4 * r));
+
+                // not fused, so that the result matches the scalar path
+                _mm_storeu_ps(output + 3 * i + 4 * r, _mm_add_ps(offsets[r], _mm_mul_ps(cell, steps[r])));
+            }
+        }
+
+        for (; i < count; i++)
+        {
+            for (int k = 0; k < 3; k++)
+            {
+                positions[i][k] = lowest[k] + static_cast<float>(quantized[3 * i + k]) * step[k];
+            }
+        }
+    }
+
+#endif
+}
@@ -9,6 +9,20 @@
 #define GLA_USE_CONSTEXPR   GLA_TRUE
 #define GLA_USE_NODISCARD   GLA_TRUE
 
+// per-operation call counters and sampled kernel timings (see instrument.h)
+#define GLA_USE_INSTRUMENTATION         GLA_FALSE
+#define GLA_USE_INSTRUMENTATION_TIMING  GLA_FALSE
+#define GLA_INSTRUMENTATION_SAMPLE_RATE 64
+
+// sse and fma paths for batched kernels, when the compiler targets them (see simd.h)
+#define GLA_USE_SIMD                    GLA_TRUE
+
+// std::thread workers for the parallel kernels (see parallel.h), needs -pthread on most toolchains
+#define GLA_USE_THREADS                 GLA_TRUE
+
+// layout of default_layout_mat (see matrix_layout.h), mat itself stays column-major
+#define GLA_USE_ROW_MAJOR_STORAGE       GLA_FALSE
+
 
 #if GLA_USE_CONSTEXPR
     #define GLA_CONSTEXPR constexpr
@@ -20,4 +34,22 @@
     #define GLA_NODISCARD [[nodiscard]]
 #else
     #define GLA_NODISCARD
+#endif
+
+#if GLA_USE_SIMD && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #define GLA_SIMD_SSE2 GLA_TRUE
+#else
+    #define GLA_SIMD_SSE2 GLA_FALSE
+#endif
+
+#if GLA_SIMD_SSE2 && defined(__FMA__)
+    #define GLA_SIMD_FMA GLA_TRUE
+#else
+    #define GLA_SIMD_FMA GLA_FALSE
+#endif
+
+#if GLA_USE_SIMD && defined(__BMI2__)
+    #define GLA_SIMD_BMI2 GLA_TRUE
+#else
+    #define GLA_SIMD_BMI2 GLA_FALSE
 #endif
\ No newline at end of file
@@ -0,0 +1,282 @@
+#pragma once
+
+#include "gla.h"
+#include "simd.h"
+#include "matrix_decompose.h"
+
+/*
+    ┌--------------------------------------------------------------------------┐
+    |                                                                          |
+    | unit dual quaternions for rigid transforms and skinning:                 |
+    |                                                                          |
+    |        real = rotation                                                   |
+    |        dual = 0.5 * translation * rotation                               |
+    |                                                                          |
+    | both parts are quaternions stored in a vec4 as { x, y, z, w }, so a      |
+    | joint takes 8 values instead of the 12 of an affine matrix.              |
+    |                                                                          |
+    | blending flips every joint into the hemisphere of the first one and      |
+    | renormalizes, which keeps the volume that linear blending loses.         |
+    |                                                                          |
+    └--------------------------------------------------------------------------┘
+*/
+
+namespace gla
+{
+    // hamilton product of two quaternions
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR vec<4, T> quaternion_multiply(const vec<4, T> &a, const vec<4, T> &b)
+    {
+        return
+        {
+            a.w * b.x + b.w * a.x + a.y * b.z - a.z * b.y,
+            a.w * b.y + b.w * a.y + a.z * b.x - a.x * b.z,
+            a.w * b.z + b.w * a.z + a.x * b.y - a.y * b.x,
+            a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z
+        };
+    }
+
+    template<typename T>
+    struct dual_quat
+    {
+        vec<4, T> real;
+        vec<4, T> dual;
+
+        // ┌----------------------------------------------------┐
+        // │    constructors                                    |
+        // └----------------------------------------------------┘
+
+        GLA_CONSTEXPR dual_quat() : real(0, 0, 0, 1), dual(0, 0, 0, 0) { }
+
+        GLA_CONSTEXPR dual_quat(const vec<4, T> &real, const vec<4, T> &dual) : real(real), dual(dual) { }
+
+        // rotation quaternion followed by a translation
+        GLA_CONSTEXPR dual_quat(const vec<4, T> &rotation, const vec<3, T> &translation) : real(rotation), dual(quaternion_multiply(vec<4, T>(translation.x, translation.y, translation.z, 0), rotation) * static_cast<T>(0.5)) { }
+
+        // the matrix must be rigid, any scale or shear is lost
+        GLA_CONSTEXPR explicit dual_quat(const mat<4, 4, T> &rigid) : dual_quat(quaternion(rigid.submatrix(3, 3)), vec<3, T>(rigid[3][0], rigid[3][1], rigid[3][2])) { }
+
+        // ┌----------------------------------------------------┐
+        // │    binary operators                                |
+        // └----------------------------------------------------┘
+
+        GLA_NODISCARD GLA_CONSTEXPR dual_quat operator + (const dual_quat &q) const { return { real + q.real, dual + q.dual }; }
+        GLA_NODISCARD GLA_CONSTEXPR dual_quat operator - (const dual_quat &q) const { return { real - q.real, dual - q.dual }; }
+
+        GLA_NODISCARD GLA_CONSTEXPR dual_quat operator * (const dual_quat &q) const
+        {
+            return { quaternion_multiply(real, q.real), quaternion_multiply(real, q.dual) + quaternion_multiply(dual, q.real) };
+        }
+
+        GLA_NODISCARD GLA_CONSTEXPR dual_quat operator * (T scalar) const { return { real * scalar, dual * scalar }; }
+
+        GLA_NODISCARD GLA_CONSTEXPR friend dual_quat operator * (T scalar, const dual_quat &q) { return { q.real * scalar, q.dual * scalar }; }
+
+        // ┌----------------------------------------------------┐
+        // │    compound assignment operators                   |
+        // └----------------------------------------------------┘
+
+        GLA_CONSTEXPR dual_quat & operator += (const dual_quat &q) { real += q.real; dual += q.dual; return *this; }
+        GLA_CONSTEXPR dual_quat & operator *= (T scalar) { real *= scalar; dual *= scalar; return *this; }
+
+        // ┌----------------------------------------------------┐
+        // │    properties                                      |
+        // └----------------------------------------------------┘
+
+        GLA_NODISCARD static GLA_CONSTEXPR dual_quat identity()
+        {
+            return { };
+        }
+
+        GLA_NODISCARD GLA_CONSTEXPR dual_quat normalized() const
+        {
+            GLA_STATIC_ASSERT(std::is_floating_point<T>::value, "function 'normalized()' only accepts floating-point value inputs!");
+
+            const T length = real.length();
+
+            GLA_ASSERT(length != 0, "the given dual quaternion has a zero real part, therefore it can not be normalized!")
+
+            return { real / length, dual / length };
+        }
+
+        GLA_NODISCARD GLA_CONSTEXPR vec<3, T> translation() const
+        {
+            const vec<4, T> t = quaternion_multiply(dual, vec<4, T>(- real.x, - real.y, - real.z, real.w));
+
+            return { 2 * t.x, 2 * t.y, 2 * t.z };
+        }
+
+        GLA_NODISCARD GLA_CONSTEXPR mat<4, 4, T> matrix() const
+        {
+            const mat<3, 3, T> r = rotation_matrix(real);
+            const vec<3, T> t = translation();
+
+            return
+            {
+                r[0][0], r[0][1], r[0][2], 0,
+                r[1][0], r[1][1], r[1][2], 0,
+                r[2][0], r[2][1], r[2][2], 0,
+
+                t.x, t.y, t.z, 1
+            };
+        }
+
+        GLA_NODISCARD GLA_CONSTEXPR vec<3, T> transform_vector(const vec<3, T> &v) const
+        {
+            const vec<3, T> r(real.x, real.y, real.z);
+
+            return v + vec<3, T>::cross(r, vec<3, T>::cross(r, v) + v * real.w) * 2;
+        }
+
+        GLA_NODISCARD GLA_CONSTEXPR vec<3, T> transform_point(const vec<3, T> &p) const
+        {
+            const vec<3, T> r(real.x, real.y, real.z);
+            const vec<3, T> d(dual.x, dual.y, dual.z);
+
+            return transform_vector(p) + (d * real.w - r * dual.w + vec<3, T>::cross(r, d)) * 2;
+        }
+    };
+
+    typedef dual_quat<float>    dualquat;
+    typedef dual_quat<double>   ddualquat;
+
+    // ┌----------------------------------------------------┐
+    // │    scalar kernels                                  |
+    // └----------------------------------------------------┘
+
+    // dual quaternions of 'count' rigid matrices, e.g. a skinning palette
+    template<typename T>
+    static void dual_quaternion_palette(const mat<4, 4, T> *rigid, std::size_t count, dual_quat<T> *output)
+    {
+        GLA_INSTRUMENT_KERNEL("dual_quaternion_palette", count);
+
+        for (std::size_t j = 0; j < count; j++)
+        {
+            output[j] = dual_quat<T>(rigid[j]);
+        }
+    }
+
+    // the same stream layout as skin_linear(), 'normals' and 'output_normals' may be null
+    template<typename T>
+    static void skin_dual_quaternion(const dual_quat<T> *palette,
+                                     const vec<3, T> *positions, const vec<3, T> *normals, const uivec4 *joints, const vec<4, T> *weights, std::size_t count,
+                                     vec<3, T> *output_positions, vec<3, T> *output_normals)
+    {
+        GLA_INSTRUMENT_KERNEL("skin_dual_quaternion", count);
+
+        const bool skin_normals = normals != nullptr && output_normals != nullptr;
+
+        for (std::size_t i = 0; i < count; i++)
+        {
+            const dual_quat<T> &pivot = palette[joints[i][0]];
+
+            dual_quat<T> blended = pivot * weights[i][0];
+
+            for (int k = 1; k < 4; k++)
+            {
+                const dual_quat<T> &joint = palette[joints[i][k]];
+
+                // shortest path, q and -q are the same rotation
+                const T weight = (vec<4, T>::dot(pivot.real, joint.real) < 0) ? - weights[i][k] : weights[i][k];
+
+                blended += joint * weight;
+            }
+
+            blended = blended.normalized();
+
+            output_positions[i] = blended.transform_point(positions[i]);
+
+            if (skin_normals)
+            {
+                output_normals[i] = blended.transform_vector(normals[i]);
+            }
+        }
+    }
+
+    // ┌----------------------------------------------------┐
+    // │    sse kernels                                     |
+    // └----------------------------------------------------┘
+
+#if GLA_SIMD_SSE2
+
+    GLA_STATIC_ASSERT(sizeof(dualquat) == 8 * sizeof(float), "dualquat must be tightly packed to be loaded as two registers!");
+
+    inline void skin_dual_quaternion(const dualquat *palette,
+                                     const vec3 *positions, const vec3 *normals, const uivec4 *joints, const vec4 *weights, std::size_t count,
+                                     vec3 *output_positions, vec3 *output_normals)
+    {
+        GLA_INSTRUMENT_KERNEL("skin_dual_quaternion", count);
+
+        const bool skin_normals = normals != nullptr && output_normals != nullptr;
+
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 sign = _mm_set1_ps(-0.0F);
+        const __m128 two = _mm_set1_ps(2);
+
+        for (std::size_t i = 0; i < count; i++)
+        {
+            const __m128 w = simd::load(weights[i]);
+
+            const dualquat &j0 = palette[joints[i].x];
+
+            const __m128 pivot = simd::load(j0.real);
+
+            __m128 real = _mm_mul_ps(pivot, simd::splat<0>(w));
+            __m128 dual = _mm_mul_ps(simd::load(j0.dual), simd::splat<0>(w));
+
+            for (int k = 1; k < 4; k++)
+            {
+                const dualquat &joint = palette[joints[i][k]];
+
+                const __m128 joint_real = simd::load(joint.real);
+
+                // shortest path, flip the weight's sign bit when the joint lies in the other hemisphere
+                const __m128 flip = _mm_and_ps(_mm_cmplt_ps(simd::sum(_mm_mul_ps(pivot, joint_real)), zero), sign);
+
+                __m128 weight;
+
+                switch (k)
+                {
+                    case 1: weight = simd::splat<1>(w); break;
+                    case 2: weight = simd::splat<2>(w); break;
+
+                    default: weight = simd::splat<3>(w); break;
+                }
+
+                weight = _mm_xor_ps(weight, flip);
+
+                real = simd::madd(joint_real, weight, real);
+                dual = simd::madd(simd::load(joint.dual), weight, dual);
+            }
+
+            const __m128 inverse_length = _mm_div_ps(_mm_set1_ps(1), _mm_sqrt_ps(simd::sum(_mm_mul_ps(real, real))));
+
+            real = _mm_mul_ps(real, inverse_length);
+            dual = _mm_mul_ps(dual, inverse_length);
+
+            const __m128 real_w = simd::splat<3>(real);
+            const __m128 dual_w = simd::splat<3>(dual);
+
+            // p + 2 * r x (r x p + w * p)
+            const __m128 p = simd::load(positions[i]);
+
+            __m128 position = simd::madd(two, simd::cross(real, simd::madd(real_w, p, simd::cross(real, p))), p);
+
+            // + 2 * (w * d - dw * r + r x d)
+            const __m128 translation = _mm_sub_ps(simd::madd(real_w, dual, simd::cross(real, dual)), _mm_mul_ps(dual_w, real));
+
+            position = simd::madd(two, translation, position);
+
+            simd::store(output_positions[i], position);
+
+            if (skin_normals)
+            {
+                const __m128 n = simd::load(normals[i]);
+
+                simd::store(output_normals[i], simd::madd(two, simd::cross(real, simd::madd(real_w, n, simd::cross(real, n))), n));
+            }
+        }
+    }
+
+#endif
+}
@@ -0,0 +1,291 @@
+#pragma once
+
+#include "gla.h"
+#include "simd.h"
+
+/*
+    ┌--------------------------------------------------------------------------┐
+    |                                                                          |
+    | eigen-decomposition of symmetric 3x3 matrices (covariance, inertia):     |
+    |                                                                          |
+    |        m = vectors * diagonal(values) * transpose(vectors)               |
+    |                                                                          |
+    | cyclic jacobi: every sweep zeroes the (0, 1), (0, 2) and (1, 2) entries  |
+    | with one plane rotation each. convergence is quadratic, the default of   |
+    | six sweeps reaches double precision on any input; the loop stops early   |
+    | once the off-diagonal is exactly zero. only the upper triangle of the    |
+    | input is read.                                                           |
+    |                                                                          |
+    | values are sorted from largest to smallest and column i of 'vectors' is  |
+    | the unit eigenvector of values[i]. the columns form a right-handed       |
+    | orthonormal basis, a rotation, so they can be used as a frame.           |
+    |                                                                          |
+    | the batched version keeps 16 matrices in lanes, one array per entry,     |
+    | and runs all sweeps on them before sorting each matrix. in float with    |
+    | GLA_SIMD_SSE2 the sweeps run four lanes per register without branches,   |
+    | a zero off-diagonal entry masks its rotation to the identity. they use   |
+    | exact square roots and divisions in the order of the scalar rotation,    |
+    | so both give identical results unless the compiler contracts the         |
+    | scalar one into fused multiply-adds.                                     |
+    |                                                                          |
+    └--------------------------------------------------------------------------┘
+*/
+
+namespace gla
+{
+    template<typename T>
+    struct symmetric_eigen
+    {
+        // largest first
+        vec<3, T> values;
+
+        // column i belongs to values[i]
+        mat<3, 3, T> vectors;
+    };
+
+    namespace detail
+    {
+        // zeroes a_pq, 'r' is the remaining index. v_p and v_q are the p-th and q-th eigenvector columns
+        template<typename T>
+        static GLA_CONSTEXPR void jacobi_rotate(T &a_pp, T &a_qq, T &a_pq, T &a_rp, T &a_rq,
+                                                T &v_p0, T &v_p1, T &v_p2, T &v_q0, T &v_q1, T &v_q2)
+        {
+            const T theta = (a_qq - a_pp) / (2 * a_pq);
+
+            // the smaller root of t^2 + 2 theta t - 1 = 0, zero when there is nothing to rotate
+            const T t = (a_pq != 0) ? std::copysign(T(1), theta) / (std::abs(theta) + std::sqrt(theta * theta + 1)) : T(0);
+
+            const T c = 1 / std::sqrt(t * t + 1);
+            const T s = t * c;
+
+            a_pp -= t * a_pq;
+            a_qq += t * a_pq;
+            a_pq = 0;
+
+            const T rp = a_rp;
+            const T rq = a_rq;
+
+            a_rp = c * rp - s * rq;
+            a_rq = s * rp + c * rq;
+
+            const T p0 = v_p0, p1 = v_p1, p2 = v_p2;
+            const T q0 = v_q0, q1 = v_q1, q2 = v_q2;
+
+            v_p0 = c * p0 - s * q0;
+            v_p1 = c * p1 - s * q1;
+            v_p2 = c * p2 - s * q2;
+
+            v_q0 = s * p0 + c * q0;
+            v_q1 = s * p1 + c * q1;
+            v_q2 = s * p2 + c * q2;
+        }
+
+        const std::size_t JACOBI_LANES = 16;
+
+        // 'sweeps' cyclic sweeps over every lane. a[k][lane] holds a00, a11, a22, a01, a02 and a12, v[column][row][lane]
+        template<typename T>
+        static void jacobi_sweeps(T (&a)[6][JACOBI_LANES], T (&v)[3][3][JACOBI_LANES], int sweeps)
+        {
+            T (&a00)[JACOBI_LANES] = a[0], (&a11)[JACOBI_LANES] = a[1], (&a22)[JACOBI_LANES] = a[2];
+            T (&a01)[JACOBI_LANES] = a[3], (&a02)[JACOBI_LANES] = a[4], (&a12)[JACOBI_LANES] = a[5];
+
+            for (int sweep = 0; sweep < sweeps; sweep++)
+            {
+                for (std::size_t l = 0; l < JACOBI_LANES; l++) jacobi_rotate(a00[l], a11[l], a01[l], a02[l], a12[l], v[0][0][l], v[0][1][l], v[0][2][l], v[1][0][l], v[1][1][l], v[1][2][l]);
+                for (std::size_t l = 0; l < JACOBI_LANES; l++) jacobi_rotate(a00[l], a22[l], a02[l], a01[l], a12[l], v[0][0][l], v[0][1][l], v[0][2][l], v[2][0][l], v[2][1][l], v[2][2][l]);
+                for (std::size_t l = 0; l < JACOBI_LANES; l++) jacobi_rotate(a11[l], a22[l], a12[l], a01[l], a02[l], v[1][0][l], v[1][1][l], v[1][2][l], v[2][0][l], v[2][1][l], v[2][2][l]);
+            }
+        }
+
+    #if GLA_SIMD_SSE2
+
+        // jacobi_rotate() on four lanes, operation for operation, the zero test becomes a mask
+        inline void jacobi_rotate(__m128 &a_pp, __m128 &a_qq, __m128 &a_pq, __m128 &a_rp, __m128 &a_rq,
+                                  __m128 &v_p0, __m128 &v_p1, __m128 &v_p2, __m128 &v_q0, __m128 &v_q1, __m128 &v_q2)
+        {
+            const __m128 one = _mm_set1_ps(1.0F);
+            const __m128 sign = _mm_set1_ps(-0.0F);
+
+            const __m128 theta = _mm_div_ps(_mm_sub_ps(a_qq, a_pp), _mm_add_ps(a_pq, a_pq));
+
+            // copysign(1, theta) / (|theta| + sqrt(theta^2 + 1)), masked to zero where a_pq is
+            const __m128 root = _mm_add_ps(_mm_andnot_ps(sign, theta), _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(theta, theta), one)));
+            const __m128 t = _mm_and_ps(_mm_cmpneq_ps(a_pq, _mm_setzero_ps()), _mm_div_ps(_mm_or_ps(_mm_and_ps(theta, sign), one), root));
+
+            const __m128 c = _mm_div_ps(one, _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(t, t), one)));
+            const __m128 s = _mm_mul_ps(t, c);
+
+            a_pp = _mm_sub_ps(a_pp, _mm_mul_ps(t, a_pq));
+            a_qq = _mm_add_ps(a_qq, _mm_mul_ps(t, a_pq));
+            a_pq = _mm_setzero_ps();
+
+            const __m128 rp = a_rp;
+            const __m128 rq = a_rq;
+
+            a_rp = _mm_sub_ps(_mm_mul_ps(c, rp), _mm_mul_ps(s, rq));
+            a_rq = _mm_add_ps(_mm_mul_ps(s, rp), _mm_mul_ps(c, rq));
+
+            __m128 *p[3] = { &v_p0, &v_p1, &v_p2 };
+            __m128 *q[3] = { &v_q0, &v_q1, &v_q2 };
+
+            for (int k = 0; k < 3; k++)
+            {
+                const __m128 pk = *p[k];
+                const __m128 qk = *q[k];
+
+                *p[k] = _mm_sub_ps(_mm_mul_ps(c, pk), _mm_mul_ps(s, qk));
+                *q[k] = _mm_add_ps(_mm_mul_ps(s, pk), _mm_mul_ps(c, qk));
+            }
+        }
+
+        // every rotation goes over the four register groups before the next one starts, the groups are independent
+        // so their divisions and square roots overlap instead of waiting on each other
+        inline void jacobi_sweeps(float (&a)[6][JACOBI_LANES], float (&v)[3][3][JACOBI_LANES], int sweeps)
+        {
+            // a_pp, a_qq, a_pq, a_rp and a_rq as rows of 'a', then the columns p and q of 'v'
+            const int rotations[3][7] = { { 0, 1, 3, 4, 5, 0, 1 }, { 0, 2, 4, 3, 5, 0, 2 }, { 1, 2, 5, 3, 4, 1, 2 } };
+
+            for (int sweep = 0; sweep < sweeps; sweep++)
+            {
+                for (const auto &rotation : rotations)
+                {
+                    float *pp = a[rotation[0]], *qq = a[rotation[1]], *pq = a[rotation[2]], *rp = a[rotation[3]], *rq = a[rotation[4]];
+
+                    float (&p)[3][JACOBI_LANES] = v[rotation[5]];
+                    float (&q)[3][JACOBI_LANES] = v[rotation[6]];
+
+                    for (std::size_t l = 0; l < JACOBI_LANES; l += 4)
+                    {
+                        __m128 a_pp = _mm_loadu_ps(pp + l), a_qq = _mm_loadu_ps(qq + l), a_pq = _mm_loadu_ps(pq + l);
+                        __m128 a_rp = _mm_loadu_ps(rp + l), a_rq = _mm_loadu_ps(rq + l);
+
+                        __m128 v_p0 = _mm_loadu_ps(p[0] + l), v_p1 = _mm_loadu_ps(p[1] + l), v_p2 = _mm_loadu_ps(p[2] + l);
+                        __m128 v_q0 = _mm_loadu_ps(q[0] + l), v_q1 = _mm_loadu_ps(q[1] + l), v_q2 = _mm_loadu_ps(q[2] + l);
+
+                        jacobi_rotate(a_pp, a_qq, a_pq, a_rp, a_rq, v_p0, v_p1, v_p2, v_q0, v_q1, v_q2);
+
+                        _mm_storeu_ps(pp + l, a_pp); _mm_storeu_ps(qq + l, a_qq); _mm_storeu_ps(pq + l, a_pq);
+                        _mm_storeu_ps(rp + l, a_rp); _mm_storeu_ps(rq + l, a_rq);
+
+                        _mm_storeu_ps(p[0] + l, v_p0); _mm_storeu_ps(p[1] + l, v_p1); _mm_storeu_ps(p[2] + l, v_p2);
+                        _mm_storeu_ps(q[0] + l, v_q0); _mm_storeu_ps(q[1] + l, v_q1); _mm_storeu_ps(q[2] + l, v_q2);
+                    }
+                }
+            }
+        }
+
+    #endif
+
+        // orders values[i] and column i by the value, largest first, and keeps the basis right-handed
+        template<typename T>
+        static GLA_CONSTEXPR void sort_eigen(T (&values)[3], T (&vectors)[3][3])
+        {
+            const int pairs[3][2] = { { 0, 1 }, { 1, 2 }, { 0, 1 } };
+
+            for (const auto &pair : pairs)
+            {
+                const int i = pair[0];
+                const int j = pair[1];
+
+                if (values[i] < values[j])
+                {
+                    std::swap(values[i], values[j]);
+
+                    for (int k = 0; k < 3; k++) std::swap(vectors[i][k], vectors[j][k]);
+                }
+            }
+
+            const T handedness = vectors[0][0] * (vectors[1][1] * vectors[2][2] - vectors[1][2] * vectors[2][1])
+                               - vectors[1][0] * (vectors[0][1] * vectors[2][2] - vectors[0][2] * vectors[2][1])
+                               + vectors[2][0] * (vectors[0][1] * vectors[1][2] - vectors[0][2] * vectors[1][1]);
+
+            if (handedness < 0)
+            {
+                for (int k = 0; k < 3; k++) vectors[2][k] = - vectors[2][k];
+            }
+        }
+    }
+
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR symmetric_eigen<T> eigen_symmetric(const mat<3, 3, T> &m, int sweeps = 6)
+    {
+        GLA_STATIC_ASSERT(std::is_floating_point<T>::value, "function 'eigen_symmetric()' only accepts floating-point value inputs!");
+
+        T a00 = m[0][0], a11 = m[1][1], a22 = m[2][2];
+        T a01 = m[1][0], a02 = m[2][0], a12 = m[2][1];
+
+        // v[column][row]
+        T v[3][3] = { { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } };
+
+        for (int sweep = 0; sweep < sweeps; sweep++)
+        {
+            if (a01 == 0 && a02 == 0 && a12 == 0) break;
+
+            detail::jacobi_rotate(a00, a11, a01, a02, a12, v[0][0], v[0][1], v[0][2], v[1][0], v[1][1], v[1][2]);
+            detail::jacobi_rotate(a00, a22, a02, a01, a12, v[0][0], v[0][1], v[0][2], v[2][0], v[2][1], v[2][2]);
+            detail::jacobi_rotate(a11, a22, a12, a01, a02, v[1][0], v[1][1], v[1][2], v[2][0], v[2][1], v[2][2]);
+        }
+
+        T values[3] = { a00, a11, a22 };
+
+        detail::sort_eigen(values, v);
+
+        symmetric_eigen<T> result;
+
+        result.values = vec<3, T>(values[0], values[1], values[2]);
+
+        for (int c = 0; c < 3; c++) result.vectors[c] = vec<3, T>(v[c][0], v[c][1], v[c][2]);
+
+        return result;
+    }
+
+    template<typename T>
+    static void eigen_symmetric(const mat<3, 3, T> *matrices, std::size_t count, symmetric_eigen<T> *output, int sweeps = 6)
+    {
+        GLA_STATIC_ASSERT(std::is_floating_point<T>::value, "function 'eigen_symmetric()' only accepts floating-point value inputs!");
+
+        GLA_INSTRUMENT_KERNEL("eigen_symmetric", count);
+
+        const std::size_t W = detail::JACOBI_LANES;
+
+        for (std::size_t first = 0; first < count; first += W)
+        {
+            const std::size_t lanes = std::min(W, count - first);
+
+            // a00, a11, a22, a01, a02 and a12 of every lane
+            T a[6][W];
+
+            // v[column][row][lane]
+            T v[3][3][W];
+
+            for (std::size_t l = 0; l < W; l++)
+            {
+                // unused lanes repeat the first matrix of the block
+                const mat<3, 3, T> &m = (l < lanes) ? matrices[first + l] : matrices[first];
+
+                a[0][l] = m[0][0]; a[1][l] = m[1][1]; a[2][l] = m[2][2];
+                a[3][l] = m[1][0]; a[4][l] = m[2][0]; a[5][l] = m[2][1];
+
+                for (int c = 0; c < 3; c++) for (int r = 0; r < 3; r++) v[c][r][l] = (c == r) ? T(1) : T(0);
+            }
+
+            detail::jacobi_sweeps(a, v, sweeps);
+
+            for (std::size_t l = 0; l < lanes; l++)
+            {
+                T values[3] = { a[0][l], a[1][l], a[2][l] };
+                T vectors[3][3];
+
+                for (int c = 0; c < 3; c++) for (int r = 0; r < 3; r++) vectors[c][r] = v[c][r][l];
+
+                detail::sort_eigen(values, vectors);
+
+                symmetric_eigen<T> &result = output[first + l];
+
+                result.values = vec<3, T>(values[0], values[1], values[2]);
+
+                for (int c = 0; c < 3; c++) result.vectors[c] = vec<3, T>(vectors[c][0], vectors[c][1], vectors[c][2]);
+            }
+        }
+    }
+}
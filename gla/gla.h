@@ -7,11 +7,13 @@
 #include <cstdlib>
 #include <iostream>
 #include <algorithm>
+#include <limits>
 #include <type_traits>
 
 #include "assert.h"
 #include "config.h"
 #include "common.h"
+#include "instrument.h"
 #include "forward.h"
 
 #include "vector.h"
@@ -0,0 +1,333 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+
+#include "config.h"
+
+/*
+    ┌--------------------------------------------------------------------------┐
+    |                                                                          |
+    | opt-in instrumentation, enabled through GLA_USE_INSTRUMENTATION:         |
+    |                                                                          |
+    |   - call counters per operation, shape and scalar type                   |
+    |   - sampled cycle timings for batched kernels                            |
+    |     (GLA_USE_INSTRUMENTATION_TIMING, every n-th call)                    |
+    |                                                                          |
+    | when disabled every hook expands to nothing and snapshot() is all zero   |
+    |                                                                          |
+    | only calls made from outside are counted: the determinant inverse()      |
+    | computes, or the minors of a mat4x4 cofactor, do not show up as calls    |
+    | of their own.                                                            |
+    |                                                                          |
+    └--------------------------------------------------------------------------┘
+*/
+
+#if GLA_USE_INSTRUMENTATION
+    #include <atomic>
+    #include <chrono>
+
+    #if defined(_MSC_VER)
+        #include <intrin.h>
+    #elif defined(__x86_64__) || defined(__i386__)
+        #include <x86intrin.h>
+    #endif
+#endif
+
+namespace gla
+{
+    namespace instrument
+    {
+        enum class operation : std::size_t
+        {
+            inverse,
+            determinant,
+            multiply,
+            normalized,
+
+            count
+        };
+
+        enum class shape : std::size_t
+        {
+            vec2,
+            vec3,
+            vec4,
+            mat2x2,
+            mat3x3,
+            mat4x4,
+
+            count
+        };
+
+        enum class scalar : std::size_t
+        {
+            f32,
+            f64,
+            other,
+
+            count
+        };
+
+        static GLA_CONSTEXPR const std::size_t MAX_KERNELS = 64;
+
+        template<typename T> struct scalar_of           { static GLA_CONSTEXPR const scalar value = scalar::other; };
+        template<>           struct scalar_of<float>    { static GLA_CONSTEXPR const scalar value = scalar::f32; };
+        template<>           struct scalar_of<double>   { static GLA_CONSTEXPR const scalar value = scalar::f64; };
+
+        struct kernel_stats
+        {
+            const char *name = nullptr;
+
+            std::uint64_t calls = 0;
+            std::uint64_t elements = 0;
+
+            // only the sampled calls contribute to these
+            std::uint64_t sampled_calls = 0;
+            std::uint64_t sampled_elements = 0;
+            std::uint64_t sampled_cycles = 0;
+
+            GLA_NODISCARD double cycles_per_element() const
+            {
+                return (sampled_elements != 0) ? static_cast<double>(sampled_cycles) / sampled_elements : 0.0;
+            }
+        };
+
+        struct snapshot_data
+        {
+            std::uint64_t counters[static_cast<std::size_t>(operation::count)]
+                                  [static_cast<std::size_t>(shape::count)]
+                                  [static_cast<std::size_t>(scalar::count)] = { };
+
+            kernel_stats kernels[MAX_KERNELS];
+
+            std::size_t kernel_count = 0;
+
+            GLA_NODISCARD std::uint64_t calls(operation op, shape s, scalar t) const
+            {
+                return counters[static_cast<std::size_t>(op)][static_cast<std::size_t>(s)][static_cast<std::size_t>(t)];
+            }
+
+            GLA_NODISCARD std::uint64_t calls(operation op) const
+            {
+                std::uint64_t total = 0;
+
+                for (std::size_t s = 0; s < static_cast<std::size_t>(shape::count); s++)
+                {
+                    for (std::size_t t = 0; t < static_cast<std::size_t>(scalar::count); t++)
+                    {
+                        total += counters[static_cast<std::size_t>(op)][s][t];
+                    }
+                }
+
+                return total;
+            }
+        };
+
+    #if GLA_USE_INSTRUMENTATION
+
+        struct kernel_slot
+        {
+            const char *name = nullptr;
+
+            std::atomic<std::uint64_t> calls { 0 };
+            std::atomic<std::uint64_t> elements { 0 };
+            std::atomic<std::uint64_t> sampled_calls { 0 };
+            std::atomic<std::uint64_t> sampled_elements { 0 };
+            std::atomic<std::uint64_t> sampled_cycles { 0 };
+        };
+
+        struct registry
+        {
+            std::atomic<std::uint64_t> counters[static_cast<std::size_t>(operation::count)]
+                                               [static_cast<std::size_t>(shape::count)]
+                                               [static_cast<std::size_t>(scalar::count)];
+
+            kernel_slot kernels[MAX_KERNELS];
+
+            // shared by every kernel registered past MAX_KERNELS
+            kernel_slot overflow;
+
+            std::atomic<std::size_t> kernel_count { 0 };
+
+            registry()
+            {
+                for (auto &op : counters) for (auto &s : op) for (auto &t : s) t.store(0, std::memory_order_relaxed);
+
+                overflow.name = "<overflow>";
+            }
+        };
+
+        // 'inline' rather than 'static' so that every translation unit shares the same counters
+        inline registry & global()
+        {
+            static registry instance;
+
+            return instance;
+        }
+
+        inline std::uint64_t cycles()
+        {
+        #if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+            return __rdtsc();
+        #else
+            return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+        #endif
+        }
+
+        template<typename T>
+        inline void count(operation op, shape s)
+        {
+            global().counters[static_cast<std::size_t>(op)]
+                             [static_cast<std::size_t>(s)]
+                             [static_cast<std::size_t>(scalar_of<T>::value)].fetch_add(1, std::memory_order_relaxed);
+        }
+
+        inline kernel_slot & register_kernel(const char *name)
+        {
+            registry &r = global();
+
+            const std::size_t index = r.kernel_count.fetch_add(1, std::memory_order_relaxed);
+
+            if (index >= MAX_KERNELS)
+            {
+                return r.overflow;
+            }
+
+            r.kernels[index].name = name;
+
+            return r.kernels[index];
+        }
+
+        // records one call of a batched kernel, timing it if this call falls on the sample rate
+        class kernel_timer
+        {
+        public:
+            kernel_timer(kernel_slot &slot, std::size_t elements) : slot(slot), elements(elements), start(0), sampled(false)
+            {
+                const std::uint64_t call = slot.calls.fetch_add(1, std::memory_order_relaxed);
+
+                slot.elements.fetch_add(elements, std::memory_order_relaxed);
+
+            #if GLA_USE_INSTRUMENTATION_TIMING
+                sampled = (call % GLA_INSTRUMENTATION_SAMPLE_RATE) == 0;
+
+                if (sampled) start = cycles();
+            #else
+                (void) call;
+            #endif
+            }
+
+            ~kernel_timer()
+            {
+                if (!sampled) return;
+
+                const std::uint64_t elapsed = cycles() - start;
+
+                slot.sampled_calls.fetch_add(1, std::memory_order_relaxed);
+                slot.sampled_elements.fetch_add(elements, std::memory_order_relaxed);
+                slot.sampled_cycles.fetch_add(elapsed, std::memory_order_relaxed);
+            }
+
+            kernel_timer(const kernel_timer &) = delete;
+            kernel_timer & operator = (const kernel_timer &) = delete;
+
+        private:
+            kernel_slot &slot;
+
+            std::size_t elements;
+            std::uint64_t start;
+
+            bool sampled;
+        };
+
+    #endif
+
+        // ┌----------------------------------------------------┐
+        // │    snapshot / reset                                |
+        // └----------------------------------------------------┘
+
+        GLA_NODISCARD inline snapshot_data snapshot()
+        {
+            snapshot_data result;
+
+        #if GLA_USE_INSTRUMENTATION
+            registry &r = global();
+
+            for (std::size_t op = 0; op < static_cast<std::size_t>(operation::count); op++)
+            {
+                for (std::size_t s = 0; s < static_cast<std::size_t>(shape::count); s++)
+                {
+                    for (std::size_t t = 0; t < static_cast<std::size_t>(scalar::count); t++)
+                    {
+                        result.counters[op][s][t] = r.counters[op][s][t].load(std::memory_order_relaxed);
+                    }
+                }
+            }
+
+            result.kernel_count = std::min(r.kernel_count.load(std::memory_order_relaxed), MAX_KERNELS);
+
+            for (std::size_t k = 0; k < result.kernel_count; k++)
+            {
+                const kernel_slot &slot = r.kernels[k];
+
+                result.kernels[k].name = slot.name;
+                result.kernels[k].calls = slot.calls.load(std::memory_order_relaxed);
+                result.kernels[k].elements = slot.elements.load(std::memory_order_relaxed);
+                result.kernels[k].sampled_calls = slot.sampled_calls.load(std::memory_order_relaxed);
+                result.kernels[k].sampled_elements = slot.sampled_elements.load(std::memory_order_relaxed);
+                result.kernels[k].sampled_cycles = slot.sampled_cycles.load(std::memory_order_relaxed);
+            }
+        #endif
+
+            return result;
+        }
+
+        // zeroes every counter, registered kernels keep their slots
+        inline void reset()
+        {
+        #if GLA_USE_INSTRUMENTATION
+            registry &r = global();
+
+            for (auto &op : r.counters) for (auto &s : op) for (auto &t : s) t.store(0, std::memory_order_relaxed);
+
+            for (std::size_t k = 0; k < MAX_KERNELS; k++)
+            {
+                r.kernels[k].calls.store(0, std::memory_order_relaxed);
+                r.kernels[k].elements.store(0, std::memory_order_relaxed);
+                r.kernels[k].sampled_calls.store(0, std::memory_order_relaxed);
+                r.kernels[k].sampled_elements.store(0, std::memory_order_relaxed);
+                r.kernels[k].sampled_cycles.store(0, std::memory_order_relaxed);
+            }
+
+            r.overflow.calls.store(0, std::memory_order_relaxed);
+            r.overflow.elements.store(0, std::memory_order_relaxed);
+            r.overflow.sampled_calls.store(0, std::memory_order_relaxed);
+            r.overflow.sampled_elements.store(0, std::memory_order_relaxed);
+            r.overflow.sampled_cycles.store(0, std::memory_order_relaxed);
+        #endif
+        }
+    }
+}
+
+// ┌----------------------------------------------------┐
+// │    hooks                                           |
+// └----------------------------------------------------┘
+
+#define GLA_INSTRUMENT_CONCAT_IMPL(a, b) a##b
+#define GLA_INSTRUMENT_CONCAT(a, b) GLA_INSTRUMENT_CONCAT_IMPL(a, b)
+
+#if GLA_USE_INSTRUMENTATION
+    // counts one call of 'op' on a 'kind' holding scalars of type 'T'
+    #define GLA_INSTRUMENT_COUNT(op, kind, T) \
+        ::gla::instrument::count<T>(::gla::instrument::operation::op, ::gla::instrument::shape::kind)
+
+    // counts (and samples the timing of) the enclosing scope as one call of a batched kernel over 'n' elements
+    #define GLA_INSTRUMENT_KERNEL(name, n)                                                                                          \
+        static ::gla::instrument::kernel_slot &GLA_INSTRUMENT_CONCAT(gla_kernel_slot_, __LINE__) = ::gla::instrument::register_kernel(name); \
+        const ::gla::instrument::kernel_timer GLA_INSTRUMENT_CONCAT(gla_kernel_timer_, __LINE__)(GLA_INSTRUMENT_CONCAT(gla_kernel_slot_, __LINE__), (n))
+#else
+    #define GLA_INSTRUMENT_COUNT(op, kind, T)
+    #define GLA_INSTRUMENT_KERNEL(name, n)
+#endif
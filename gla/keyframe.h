@@ -0,0 +1,285 @@
+#pragma once
+
+#include <vector>
+
+#include "gla.h"
+
+/*
+    ┌--------------------------------------------------------------------------┐
+    |                                                                          |
+    | keyframe tracks:                                                         |
+    |                                                                          |
+    |   key times and key values live in two separate arrays, and every        |
+    |   playing instance keeps its own cursor (the index of the last segment   |
+    |   it sampled). monotonic playback only ever steps the cursor forward,    |
+    |   so sampling is amortized O(1); jumps fall back to a binary search.     |
+    |                                                                          |
+    |   sampling before the first or after the last key holds that key.        |
+    |   cubic interpolation is a uniform catmull-rom spline through the keys.  |
+    |                                                                          |
+    | rotation tracks hold quaternions { x, y, z, w } and use                  |
+    | quaternion_blend, which takes the shortest path and renormalizes.        |
+    |                                                                          |
+    └--------------------------------------------------------------------------┘
+*/
+
+namespace gla
+{
+    enum class interpolation
+    {
+        step,
+        linear,
+        cubic
+    };
+
+    template<typename V>
+    struct keyframe_blend
+    {
+        // 't' is already within [0, 1], so unlike lerp() there is nothing to clamp
+        GLA_NODISCARD static GLA_CONSTEXPR V linear(const V &a, const V &b, float t)
+        {
+            return a + (b - a) * t;
+        }
+
+        GLA_NODISCARD static GLA_CONSTEXPR V cubic(const V &p0, const V &p1, const V &p2, const V &p3, float t)
+        {
+            const float t2 = t * t;
+            const float t3 = t2 * t;
+
+            return (p1 * 2 + (p2 - p0) * t + (p0 * 2 - p1 * 5 + p2 * 4 - p3) * t2 + (p1 * 3 - p0 - p2 * 3 + p3) * t3) * 0.5F;
+        }
+    };
+
+    template<typename T>
+    struct quaternion_blend
+    {
+        GLA_NODISCARD static GLA_CONSTEXPR vec<4, T> linear(const vec<4, T> &a, const vec<4, T> &b, float t)
+        {
+            return keyframe_blend<vec<4, T>>::linear(a, align(a, b), t).normalized();
+        }
+
+        GLA_NODISCARD static GLA_CONSTEXPR vec<4, T> cubic(const vec<4, T> &p0, const vec<4, T> &p1, const vec<4, T> &p2, const vec<4, T> &p3, float t)
+        {
+            const vec<4, T> q2 = align(p1, p2);
+
+            return keyframe_blend<vec<4, T>>::cubic(align(p1, p0), p1, q2, align(q2, p3), t).normalized();
+        }
+
+    private:
+        // 'q' or '-q', whichever is closer to 'reference'
+        GLA_NODISCARD static GLA_CONSTEXPR vec<4, T> align(const vec<4, T> &reference, const vec<4, T> &q)
+        {
+            return (vec<4, T>::dot(reference, q) < 0) ? q.opposite() : q;
+        }
+    };
+
+    template<typename V, typename B = keyframe_blend<V>>
+    struct keyframe_track
+    {
+        std::vector<float> times;
+        std::vector<V> values;
+
+        interpolation mode;
+
+        // ┌----------------------------------------------------┐
+        // │    constructors                                    |
+        // └----------------------------------------------------┘
+
+        keyframe_track() : mode(interpolation::linear) { }
+
+        explicit keyframe_track(interpolation mode) : mode(mode) { }
+
+        // ┌----------------------------------------------------┐
+        // │    properties                                      |
+        // └----------------------------------------------------┘
+
+        GLA_NODISCARD std::size_t size() const
+        {
+            return times.size();
+        }
+
+        GLA_NODISCARD float duration() const
+        {
+            return times.empty() ? 0 : times.back() - times.front();
+        }
+
+        // keys must be inserted in ascending time order
+        void insert(float time, const V &value)
+        {
+            GLA_ASSERT(times.empty() || time > times.back(), "keyframes must be inserted in ascending time order!")
+
+            times.push_back(time);
+            values.push_back(value);
+        }
+
+        // index 'i' of the segment [ times[i], times[i + 1] ) holding 'time', starting the search at 'cursor'
+        GLA_NODISCARD std::size_t seek(float time, std::size_t cursor) const
+        {
+            const std::size_t last = times.size() - 1;
+
+            if (cursor >= last) cursor = (last > 0) ? last - 1 : 0;
+
+            // monotonic playback, a few steps forward at most
+            if (time >= times[cursor])
+            {
+                for (int step = 0; step < 4; step++)
+                {
+                    if (cursor + 1 >= last || time < times[cursor + 1]) return cursor;
+
+                    cursor++;
+                }
+            }
+
+            // a jump, binary search the keys
+            const std::size_t upper = std::upper_bound(times.begin(), times.end(), time) - times.begin();
+
+            return (upper == 0) ? 0 : std::min(upper - 1, (last > 0) ? last - 1 : 0);
+        }
+
+        // samples the track at 'time', updating 'cursor' for the next call
+        GLA_NODISCARD V sample(float time, std::size_t &cursor) const
+        {
+            GLA_ASSERT(!times.empty(), "trying to sample an empty keyframe track!")
+
+            if (times.size() == 1 || time <= times.front())
+            {
+                cursor = 0;
+
+                return values.front();
+            }
+
+            if (time >= times.back())
+            {
+                cursor = times.size() - 2;
+
+                return values.back();
+            }
+
+            cursor = seek(time, cursor);
+
+            return evaluate(cursor, (time - times[cursor]) / (times[cursor + 1] - times[cursor]));
+        }
+
+        GLA_NODISCARD V sample(float time) const
+        {
+            std::size_t cursor = 0;
+
+            return sample(time, cursor);
+        }
+
+        // value within segment 'i' at the normalized position 't'
+        GLA_NODISCARD V evaluate(std::size_t i, float t) const
+        {
+            switch (mode)
+            {
+                case interpolation::step: return values[i];
+
+                case interpolation::linear: return B::linear(values[i], values[i + 1], t);
+
+                default:
+                {
+                    const std::size_t last = values.size() - 1;
+
+                    // the end keys are repeated to close the spline
+                    const V &p0 = values[(i > 0) ? i - 1 : 0];
+                    const V &p3 = values[(i + 2 <= last) ? i + 2 : last];
+
+                    return B::cubic(p0, values[i], values[i + 1], p3, t);
+                }
+            }
+        }
+    };
+
+    // ┌----------------------------------------------------┐
+    // │    batched sampling                                |
+    // └----------------------------------------------------┘
+
+    // samples 'count' tracks at their own 'times', each with its own cursor
+    template<typename V, typename B>
+    static void sample(const keyframe_track<V, B> *tracks, std::size_t *cursors, const float *times, std::size_t count, V *output)
+    {
+        GLA_INSTRUMENT_KERNEL("keyframe_track::sample", count);
+
+        static GLA_CONSTEXPR const std::size_t CHUNK = 64;
+
+        std::size_t segments[CHUNK];
+        float weights[CHUNK];
+
+        for (std::size_t begin = 0; begin < count; begin += CHUNK)
+        {
+            const std::size_t end = std::min(begin + CHUNK, count);
+
+            // first pass, find the segments, so that the evaluation below does not stall on the searches
+            for (std::size_t i = begin; i < end; i++)
+            {
+                const keyframe_track<V, B> &track = tracks[i];
+
+                GLA_ASSERT(!track.times.empty(), "trying to sample an empty keyframe track!")
+
+                const float time = times[i];
+
+                std::size_t segment;
+                float weight;
+
+                if (track.size() == 1 || time <= track.times.front())
+                {
+                    segment = 0;
+                    weight = 0;
+                }
+                else if (time >= track.times.back())
+                {
+                    segment = track.size() - 2;
+                    weight = 1;
+                }
+                else
+                {
+                    segment = track.seek(time, cursors[i]);
+                    weight = (time - track.times[segment]) / (track.times[segment + 1] - track.times[segment]);
+                }
+
+                cursors[i] = segment;
+
+                segments[i - begin] = segment;
+                weights[i - begin] = weight;
+            }
+
+            // second pass, interpolate
+            for (std::size_t i = begin; i < end; i++)
+            {
+                const keyframe_track<V, B> &track = tracks[i];
+
+                const std::size_t segment = segments[i - begin];
+                const float weight = weights[i - begin];
+
+                if (track.size() == 1)
+                {
+                    output[i] = track.values.front();
+                }
+                else if (weight >= 1)
+                {
+                    output[i] = track.values[segment + 1];
+                }
+                else
+                {
+                    output[i] = track.evaluate(segment, weight);
+                }
+            }
+        }
+    }
+
+    // samples 'count' tracks at the same 'time'
+    template<typename V, typename B>
+    static void sample(const keyframe_track<V, B> *tracks, std::size_t *cursors, float time, std::size_t count, V *output)
+    {
+        static GLA_CONSTEXPR const std::size_t CHUNK = 256;
+
+        float times[CHUNK];
+
+        std::fill(times, times + CHUNK, time);
+
+        for (std::size_t begin = 0; begin < count; begin += CHUNK)
+        {
+            sample(tracks + begin, cursors + begin, times, std::min(CHUNK, count - begin), output + begin);
+        }
+    }
+}
@@ -0,0 +1,494 @@
+#pragma once
+
+#include <limits>
+
+#include "gla.h"
+
+/*
+    ┌--------------------------------------------------------------------------┐
+    |                                                                          |
+    | small dense solvers for a * x = b, 2x2 up to 4x4, without an inverse:    |
+    |                                                                          |
+    |   lu          partial pivoting by rows, any non-singular matrix          |
+    |   cholesky    a = l * transpose(l), symmetric positive-definite only,    |
+    |               reads the lower triangle, half the work of lu              |
+    |                                                                          |
+    | a pivot (lu) or diagonal (cholesky) below 'tolerance' times the largest  |
+    | absolute entry is reported as a status instead of asserting. the         |
+    | default tolerance is N * epsilon of T.                                   |
+    |                                                                          |
+    | every solver comes as a single system, an array of systems, and a soa    |
+    | batch where each matrix entry and each vector component is its own       |
+    | stream:                                                                  |
+    |                                                                          |
+    |   a[c * N + r][i]    entry (column c, row r) of system i                 |
+    |   b[r][i], x[r][i]   component r of system i                             |
+    |                                                                          |
+    | the soa kernels work on blocks of systems with the system index as the   |
+    | innermost loop, which the compiler turns into simd lanes.                |
+    |                                                                          |
+    └--------------------------------------------------------------------------┘
+*/
+
+namespace gla
+{
+    enum class solve_status
+    {
+        ok,
+        near_singular,
+        not_positive_definite
+    };
+
+    template<typename T, std::size_t N>
+    GLA_NODISCARD static GLA_CONSTEXPR T default_solve_tolerance()
+    {
+        return static_cast<T>(N) * std::numeric_limits<T>::epsilon();
+    }
+
+    template<std::size_t N, typename T>
+    struct lu_factors
+    {
+        // unit lower triangle below the diagonal, upper triangle on and above it, rows in pivot order
+        mat<N, N, T> lu;
+
+        // row i of lu is row permutation[i] of the input
+        std::uint8_t permutation[N];
+
+        solve_status status;
+    };
+
+    template<std::size_t N, typename T>
+    struct cholesky_factors
+    {
+        // lower triangle, the upper one is zero
+        mat<N, N, T> l;
+
+        solve_status status;
+    };
+
+    namespace detail
+    {
+        template<std::size_t N, typename T>
+        GLA_NODISCARD static GLA_CONSTEXPR T largest_entry(const mat<N, N, T> &m)
+        {
+            T result = 0;
+
+            for (std::size_t c = 0; c < N; c++) for (std::size_t r = 0; r < N; r++) result = std::max(result, std::abs(m[c][r]));
+
+            return result;
+        }
+    }
+
+    // ┌----------------------------------------------------┐
+    // │    lu                                              |
+    // └----------------------------------------------------┘
+
+    template<std::size_t N, typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR lu_factors<N, T> lu_decompose(const mat<N, N, T> &m, T tolerance = default_solve_tolerance<T, N>())
+    {
+        lu_factors<N, T> f { m, { }, solve_status::ok };
+
+        for (std::size_t i = 0; i < N; i++) f.permutation[i] = static_cast<std::uint8_t>(i);
+
+        const T threshold = tolerance * detail::largest_entry(m);
+
+        // entry (row r, column c) is lu[c][r]
+        mat<N, N, T> &a = f.lu;
+
+        for (std::size_t k = 0; k < N; k++)
+        {
+            std::size_t pivot = k;
+
+            for (std::size_t r = k + 1; r < N; r++)
+            {
+                if (std::abs(a[k][r]) > std::abs(a[k][pivot])) pivot = r;
+            }
+
+            if (pivot != k)
+            {
+                for (std::size_t c = 0; c < N; c++) std::swap(a[c][k], a[c][pivot]);
+
+                std::swap(f.permutation[k], f.permutation[pivot]);
+            }
+
+            if (std::abs(a[k][k]) <= threshold)
+            {
+                f.status = solve_status::near_singular;
+
+                return f;
+            }
+
+            for (std::size_t r = k + 1; r < N; r++)
+            {
+                const T factor = a[k][r] / a[k][k];
+
+                a[k][r] = factor;
+
+                for (std::size_t c = k + 1; c < N; c++) a[c][r] -= factor * a[c][k];
+            }
+        }
+
+        return f;
+    }
+
+    template<std::size_t N, typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR vec<N, T> lu_solve(const lu_factors<N, T> &f, const vec<N, T> &b)
+    {
+        GLA_ASSERT(f.status == solve_status::ok, "trying to solve with a failed lu factorization!")
+
+        vec<N, T> x;
+
+        // forward, l * y = p * b
+        for (std::size_t r = 0; r < N; r++)
+        {
+            T sum = b[f.permutation[r]];
+
+            for (std::size_t c = 0; c < r; c++) sum -= f.lu[c][r] * x[c];
+
+            x[r] = sum;
+        }
+
+        // backward, u * x = y
+        for (std::size_t r = N; r-- > 0;)
+        {
+            T sum = x[r];
+
+            for (std::size_t c = r + 1; c < N; c++) sum -= f.lu[c][r] * x[c];
+
+            x[r] = sum / f.lu[r][r];
+        }
+
+        return x;
+    }
+
+    // 'x' is only written when the system could be solved
+    template<std::size_t N, typename T>
+    static GLA_CONSTEXPR solve_status solve_lu(const mat<N, N, T> &a, const vec<N, T> &b, vec<N, T> &x, T tolerance = default_solve_tolerance<T, N>())
+    {
+        const lu_factors<N, T> f = lu_decompose(a, tolerance);
+
+        if (f.status == solve_status::ok) x = lu_solve(f, b);
+
+        return f.status;
+    }
+
+    // ┌----------------------------------------------------┐
+    // │    cholesky                                        |
+    // └----------------------------------------------------┘
+
+    template<std::size_t N, typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR cholesky_factors<N, T> cholesky_decompose(const mat<N, N, T> &m, T tolerance = default_solve_tolerance<T, N>())
+    {
+        cholesky_factors<N, T> f { mat<N, N, T>(), solve_status::ok };
+
+        const T threshold = tolerance * detail::largest_entry(m);
+
+        // entry (row r, column c) is l[c][r]
+        for (std::size_t j = 0; j < N; j++)
+        {
+            T diagonal = m[j][j];
+
+            for (std::size_t k = 0; k < j; k++) diagonal -= f.l[k][j] * f.l[k][j];
+
+            if (diagonal <= threshold)
+            {
+                f.status = solve_status::not_positive_definite;
+
+                return f;
+            }
+
+            f.l[j][j] = std::sqrt(diagonal);
+
+            for (std::size_t r = j + 1; r < N; r++)
+            {
+                T sum = m[j][r];
+
+                for (std::size_t k = 0; k < j; k++) sum -= f.l[k][r] * f.l[k][j];
+
+                f.l[j][r] = sum / f.l[j][j];
+            }
+        }
+
+        return f;
+    }
+
+    template<std::size_t N, typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR vec<N, T> cholesky_solve(const cholesky_factors<N, T> &f, const vec<N, T> &b)
+    {
+        GLA_ASSERT(f.status == solve_status::ok, "trying to solve with a failed cholesky factorization!")
+
+        vec<N, T> x;
+
+        // forward, l * y = b
+        for (std::size_t r = 0; r < N; r++)
+        {
+            T sum = b[r];
+
+            for (std::size_t c = 0; c < r; c++) sum -= f.l[c][r] * x[c];
+
+            x[r] = sum / f.l[r][r];
+        }
+
+        // backward, transpose(l) * x = y
+        for (std::size_t r = N; r-- > 0;)
+        {
+            T sum = x[r];
+
+            for (std::size_t c = r + 1; c < N; c++) sum -= f.l[r][c] * x[c];
+
+            x[r] = sum / f.l[r][r];
+        }
+
+        return x;
+    }
+
+    // 'x' is only written when the system could be solved
+    template<std::size_t N, typename T>
+    static GLA_CONSTEXPR solve_status solve_cholesky(const mat<N, N, T> &a, const vec<N, T> &b, vec<N, T> &x, T tolerance = default_solve_tolerance<T, N>())
+    {
+        const cholesky_factors<N, T> f = cholesky_decompose(a, tolerance);
+
+        if (f.status == solve_status::ok) x = cholesky_solve(f, b);
+
+        return f.status;
+    }
+
+    // ┌----------------------------------------------------┐
+    // │    arrays of systems                               |
+    // └----------------------------------------------------┘
+
+    // failed systems get a zero solution
+    template<std::size_t N, typename T>
+    static void solve_lu(const mat<N, N, T> *a, const vec<N, T> *b, std::size_t count, vec<N, T> *x, solve_status *status, T tolerance = default_solve_tolerance<T, N>())
+    {
+        GLA_INSTRUMENT_KERNEL("solve_lu", count);
+
+        for (std::size_t i = 0; i < count; i++)
+        {
+            x[i] = vec<N, T>();
+
+            status[i] = solve_lu(a[i], b[i], x[i], tolerance);
+        }
+    }
+
+    template<std::size_t N, typename T>
+    static void solve_cholesky(const mat<N, N, T> *a, const vec<N, T> *b, std::size_t count, vec<N, T> *x, solve_status *status, T tolerance = default_solve_tolerance<T, N>())
+    {
+        GLA_INSTRUMENT_KERNEL("solve_cholesky", count);
+
+        for (std::size_t i = 0; i < count; i++)
+        {
+            x[i] = vec<N, T>();
+
+            status[i] = solve_cholesky(a[i], b[i], x[i], tolerance);
+        }
+    }
+
+    // ┌----------------------------------------------------┐
+    // │    soa batches                                     |
+    // └----------------------------------------------------┘
+
+    namespace detail
+    {
+        // systems per block, the lane count of the innermost loops
+        static GLA_CONSTEXPR const std::size_t SOLVE_BLOCK = 16;
+
+        // gathers a block as a[row][column][lane], padding unused lanes with the identity
+        template<std::size_t N, typename T>
+        static void load_block(const T *const *a, const T *const *b, std::size_t first, std::size_t lanes,
+                               T (&m)[N][N][SOLVE_BLOCK], T (&y)[N][SOLVE_BLOCK], T (&threshold)[SOLVE_BLOCK], T tolerance)
+        {
+            for (std::size_t l = 0; l < SOLVE_BLOCK; l++) threshold[l] = 0;
+
+            for (std::size_t c = 0; c < N; c++)
+            {
+                for (std::size_t r = 0; r < N; r++)
+                {
+                    for (std::size_t l = 0; l < SOLVE_BLOCK; l++)
+                    {
+                        m[r][c][l] = (l < lanes) ? a[c * N + r][first + l] : static_cast<T>(r == c);
+
+                        threshold[l] = std::max(threshold[l], std::abs(m[r][c][l]));
+                    }
+                }
+            }
+
+            for (std::size_t r = 0; r < N; r++)
+            {
+                for (std::size_t l = 0; l < SOLVE_BLOCK; l++) y[r][l] = (l < lanes) ? b[r][first + l] : 0;
+            }
+
+            for (std::size_t l = 0; l < SOLVE_BLOCK; l++) threshold[l] *= tolerance;
+        }
+
+        template<std::size_t N, typename T>
+        static void store_block(const T (&y)[N][SOLVE_BLOCK], const solve_status (&result)[SOLVE_BLOCK], std::size_t first, std::size_t lanes,
+                                T *const *x, solve_status *status)
+        {
+            for (std::size_t r = 0; r < N; r++)
+            {
+                for (std::size_t l = 0; l < lanes; l++) x[r][first + l] = (result[l] == solve_status::ok) ? y[r][l] : 0;
+            }
+
+            for (std::size_t l = 0; l < lanes; l++) status[first + l] = result[l];
+        }
+    }
+
+    // failed systems get a zero solution
+    template<std::size_t N, typename T>
+    static void solve_lu(const T *const *a, const T *const *b, std::size_t count, T *const *x, solve_status *status, T tolerance = default_solve_tolerance<T, N>())
+    {
+        GLA_INSTRUMENT_KERNEL("solve_lu", count);
+
+        const std::size_t W = detail::SOLVE_BLOCK;
+
+        for (std::size_t first = 0; first < count; first += W)
+        {
+            const std::size_t lanes = std::min(W, count - first);
+
+            T m[N][N][W];
+            T y[N][W];
+            T threshold[W];
+
+            solve_status result[W];
+
+            detail::load_block<N>(a, b, first, lanes, m, y, threshold, tolerance);
+
+            for (std::size_t l = 0; l < W; l++) result[l] = solve_status::ok;
+
+            for (std::size_t k = 0; k < N; k++)
+            {
+                // the pivot search differs per lane, the swaps are the only per-lane branches
+                for (std::size_t l = 0; l < W; l++)
+                {
+                    std::size_t pivot = k;
+
+                    for (std::size_t r = k + 1; r < N; r++)
+                    {
+                        if (std::abs(m[r][k][l]) > std::abs(m[pivot][k][l])) pivot = r;
+                    }
+
+                    if (pivot != k)
+                    {
+                        for (std::size_t c = 0; c < N; c++) std::swap(m[k][c][l], m[pivot][c][l]);
+
+                        std::swap(y[k][l], y[pivot][l]);
+                    }
+
+                    // a failed lane carries on with a unit pivot, its result is discarded
+                    if (std::abs(m[k][k][l]) <= threshold[l])
+                    {
+                        result[l] = solve_status::near_singular;
+
+                        m[k][k][l] = 1;
+                    }
+                }
+
+                for (std::size_t r = k + 1; r < N; r++)
+                {
+                    T factor[W];
+
+                    for (std::size_t l = 0; l < W; l++) factor[l] = m[r][k][l] / m[k][k][l];
+
+                    for (std::size_t c = k + 1; c < N; c++)
+                    {
+                        for (std::size_t l = 0; l < W; l++) m[r][c][l] -= factor[l] * m[k][c][l];
+                    }
+
+                    for (std::size_t l = 0; l < W; l++) y[r][l] -= factor[l] * y[k][l];
+                }
+            }
+
+            for (std::size_t r = N; r-- > 0;)
+            {
+                for (std::size_t c = r + 1; c < N; c++)
+                {
+                    for (std::size_t l = 0; l < W; l++) y[r][l] -= m[r][c][l] * y[c][l];
+                }
+
+                for (std::size_t l = 0; l < W; l++) y[r][l] /= m[r][r][l];
+            }
+
+            detail::store_block<N>(y, result, first, lanes, x, status);
+        }
+    }
+
+    template<std::size_t N, typename T>
+    static void solve_cholesky(const T *const *a, const T *const *b, std::size_t count, T *const *x, solve_status *status, T tolerance = default_solve_tolerance<T, N>())
+    {
+        GLA_INSTRUMENT_KERNEL("solve_cholesky", count);
+
+        const std::size_t W = detail::SOLVE_BLOCK;
+
+        for (std::size_t first = 0; first < count; first += W)
+        {
+            const std::size_t lanes = std::min(W, count - first);
+
+            // the factor overwrites the lower triangle of the block
+            T m[N][N][W];
+            T y[N][W];
+            T threshold[W];
+
+            solve_status result[W];
+
+            detail::load_block<N>(a, b, first, lanes, m, y, threshold, tolerance);
+
+            for (std::size_t l = 0; l < W; l++) result[l] = solve_status::ok;
+
+            for (std::size_t j = 0; j < N; j++)
+            {
+                for (std::size_t k = 0; k < j; k++)
+                {
+                    for (std::size_t l = 0; l < W; l++) m[j][j][l] -= m[j][k][l] * m[j][k][l];
+                }
+
+                for (std::size_t l = 0; l < W; l++)
+                {
+                    // a failed lane carries on with a unit diagonal, its result is discarded
+                    if (m[j][j][l] <= threshold[l])
+                    {
+                        result[l] = solve_status::not_positive_definite;
+
+                        m[j][j][l] = 1;
+                    }
+
+                    m[j][j][l] = std::sqrt(m[j][j][l]);
+                }
+
+                for (std::size_t r = j + 1; r < N; r++)
+                {
+                    for (std::size_t k = 0; k < j; k++)
+                    {
+                        for (std::size_t l = 0; l < W; l++) m[r][j][l] -= m[r][k][l] * m[j][k][l];
+                    }
+
+                    for (std::size_t l = 0; l < W; l++) m[r][j][l] /= m[j][j][l];
+                }
+            }
+
+            // forward, l * y = b
+            for (std::size_t r = 0; r < N; r++)
+            {
+                for (std::size_t c = 0; c < r; c++)
+                {
+                    for (std::size_t l = 0; l < W; l++) y[r][l] -= m[r][c][l] * y[c][l];
+                }
+
+                for (std::size_t l = 0; l < W; l++) y[r][l] /= m[r][r][l];
+            }
+
+            // backward, transpose(l) * x = y
+            for (std::size_t r = N; r-- > 0;)
+            {
+                for (std::size_t c = r + 1; c < N; c++)
+                {
+                    for (std::size_t l = 0; l < W; l++) y[r][l] -= m[c][r][l] * y[c][l];
+                }
+
+                for (std::size_t l = 0; l < W; l++) y[r][l] /= m[r][r][l];
+            }
+
+            detail::store_block<N>(y, result, first, lanes, x, status);
+        }
+    }
+}
@@ -65,6 +65,8 @@ namespace gla
 
         GLA_NODISCARD GLA_CONSTEXPR mat operator * (const mat &m) const
         {
+            GLA_INSTRUMENT_COUNT(multiply, mat2x2, T);
+
             mat result;
 
             for (int c = 0; c < columns(); c++)
@@ -85,15 +87,17 @@ namespace gla
 
         GLA_NODISCARD GLA_CONSTEXPR mat operator * (T scalar) const
         {
+            mat result;
+
             for (int c = 0; c < columns(); c++)
             {
                 for (int r = 0; r < rows(); r++)
                 {
-                    values[c][r] *= scalar;
+                    result[c][r] = values[c][r] * scalar;
                 }
             }
 
-            return *this;
+            return result;
         }
 
 		GLA_NODISCARD GLA_CONSTEXPR friend mat operator * (T scalar, const mat &m)
@@ -143,6 +147,8 @@ namespace gla
 
         GLA_CONSTEXPR mat & operator *= (const mat &m)
         {
+            GLA_INSTRUMENT_COUNT(multiply, mat2x2, T);
+
             mat result;
 
             for (int c = 0; c < columns(); c++)
@@ -163,6 +169,11 @@ namespace gla
             return *this;
         }
 
+        GLA_CONSTEXPR mat & operator *= (T scalar)
+        {
+            return scale_in_place(scalar);
+        }
+
         // ┌----------------------------------------------------┐
         // │    comparison operators                            |
         // └----------------------------------------------------┘
@@ -220,7 +231,7 @@ namespace gla
             return identity;
         }
 
-        GLA_NODISCARD GLA_CONSTEXPR mat transpose()
+        GLA_NODISCARD GLA_CONSTEXPR mat transpose() const
         {
             mat result;
 
@@ -235,7 +246,7 @@ namespace gla
             return result;
         }
 
-        GLA_NODISCARD GLA_CONSTEXPR mat cofactor()
+        GLA_NODISCARD GLA_CONSTEXPR mat cofactor() const
         {
             mat result;
 
@@ -247,26 +258,105 @@ namespace gla
             return result;
         }
 
-        GLA_NODISCARD GLA_CONSTEXPR mat adjugate()
+        GLA_NODISCARD GLA_CONSTEXPR mat adjugate() const
         {
             return cofactor().transpose();
         }
 
-        GLA_NODISCARD GLA_CONSTEXPR mat inverse()
+        GLA_NODISCARD GLA_CONSTEXPR mat inverse() const
         {
+            GLA_INSTRUMENT_COUNT(inverse, mat2x2, T);
+
+            const T determinant = uncounted_determinant();
+
             GLA_ASSERT(determinant != 0, "the given mat2x2 is singular, therefore it does not have an inverse!")
 
-            return adjugate() * (1 / determinant());
+            return (1 / determinant) * adjugate();
         }
 
-        GLA_NODISCARD GLA_CONSTEXPR T trace()
+        GLA_NODISCARD GLA_CONSTEXPR T trace() const
         {
             return values[0][0] + values[1][1];
         }
 
-        GLA_NODISCARD GLA_CONSTEXPR T determinant()
+        GLA_NODISCARD GLA_CONSTEXPR T determinant() const
         {
-            return values[0][0] * values[1][1] - values[0][1] * values[1][0];
+            GLA_INSTRUMENT_COUNT(determinant, mat2x2, T);
+
+            return uncounted_determinant();
+        }
+
+        // ┌----------------------------------------------------┐
+        // │    in-place operations                             |
+        // └----------------------------------------------------┘
+
+        GLA_CONSTEXPR mat & transpose_in_place()
+        {
+            for (int c = 0; c < columns(); c++)
+            {
+                for (int r = c + 1; r < rows(); r++)
+                {
+                    const T value = values[c][r];
+
+                    values[c][r] = values[r][c];
+                    values[r][c] = value;
+                }
+            }
+
+            return *this;
+        }
+
+        GLA_CONSTEXPR mat & cofactor_in_place()
+        {
+            const T a = values[0][0];
+
+            values[0][0] =   values[1][1];
+            values[1][1] =   a;
+
+            const T b = values[0][1];
+
+            values[0][1] = - values[1][0];
+            values[1][0] = - b;
+
+            return *this;
+        }
+
+        GLA_CONSTEXPR mat & adjugate_in_place()
+        {
+            return cofactor_in_place().transpose_in_place();
+        }
+
+        GLA_CONSTEXPR mat & invert_in_place()
+        {
+            GLA_INSTRUMENT_COUNT(inverse, mat2x2, T);
+
+            const T determinant = uncounted_determinant();
+
+            GLA_ASSERT(determinant != 0, "the given mat2x2 is singular, therefore it does not have an inverse!")
+
+            const T inverse_determinant = 1 / determinant;
+
+            const T a = values[0][0];
+
+            values[0][0] =   values[1][1] * inverse_determinant;
+            values[0][1] = - values[0][1] * inverse_determinant;
+            values[1][0] = - values[1][0] * inverse_determinant;
+            values[1][1] =   a * inverse_determinant;
+
+            return *this;
+        }
+
+        GLA_CONSTEXPR mat & scale_in_place(T scalar)
+        {
+            for (int c = 0; c < columns(); c++)
+            {
+                for (int r = 0; r < rows(); r++)
+                {
+                    values[c][r] *= scalar;
+                }
+            }
+
+            return *this;
         }
 
         void insert(const float (&values)[2][2])
@@ -279,5 +369,12 @@ namespace gla
                 }
             }
         }
+
+    private:
+        // determinant() without the instrumentation hook, for the library's own calls
+        GLA_NODISCARD GLA_CONSTEXPR T uncounted_determinant() const
+        {
+            return values[0][0] * values[1][1] - values[0][1] * values[1][0];
+        }
     };
 }
\ No newline at end of file
@@ -68,6 +68,8 @@ namespace gla
 
         GLA_NODISCARD GLA_CONSTEXPR mat operator * (const mat &m) const
         {
+            GLA_INSTRUMENT_COUNT(multiply, mat3x3, T);
+
             mat result;
 
             for (int c = 0; c < columns(); c++)
@@ -88,15 +90,17 @@ namespace gla
 
         GLA_NODISCARD GLA_CONSTEXPR mat operator * (T scalar) const
         {
+            mat result;
+
             for (int c = 0; c < columns(); c++)
             {
                 for (int r = 0; r < rows(); r++)
                 {
-                    values[c][r] *= scalar;
+                    result[c][r] = values[c][r] * scalar;
                 }
             }
 
-            return *this;
+            return result;
         }
 
 		GLA_NODISCARD GLA_CONSTEXPR friend mat operator * (T scalar, const mat &m)
@@ -146,6 +150,8 @@ namespace gla
 
         GLA_CONSTEXPR mat & operator *= (const mat &m)
         {
+            GLA_INSTRUMENT_COUNT(multiply, mat3x3, T);
+
             mat result;
 
             for (int c = 0; c < columns(); c++)
@@ -166,6 +172,11 @@ namespace gla
             return *this;
         }
 
+        GLA_CONSTEXPR mat & operator *= (T scalar)
+        {
+            return scale_in_place(scalar);
+        }
+
         // ┌----------------------------------------------------┐
         // │    comparison operators                            |
         // └----------------------------------------------------┘
@@ -224,7 +235,7 @@ namespace gla
             return identity;
         }
 
-        GLA_NODISCARD GLA_CONSTEXPR mat transpose()
+        GLA_NODISCARD GLA_CONSTEXPR mat transpose() const
         {
             mat result;
 
@@ -239,7 +250,7 @@ namespace gla
             return result;
         }
 
-        GLA_NODISCARD GLA_CONSTEXPR mat cofactor()
+        GLA_NODISCARD GLA_CONSTEXPR mat cofactor() const
         {
             mat result;
 
@@ -258,32 +269,32 @@ namespace gla
             return result;
         }
 
-        GLA_NODISCARD GLA_CONSTEXPR mat adjugate()
+        GLA_NODISCARD GLA_CONSTEXPR mat adjugate() const
         {
             return cofactor().transpose();
         }
 
-        GLA_NODISCARD GLA_CONSTEXPR mat inverse()
+        GLA_NODISCARD GLA_CONSTEXPR mat inverse() const
         {
+            GLA_INSTRUMENT_COUNT(inverse, mat3x3, T);
+
+            const T determinant = uncounted_determinant();
+
             GLA_ASSERT(determinant != 0, "the given mat3x3 is singular, therefore it does not have an inverse!")
 
-            return adjugate() * (1 / determinant());
+            return (1 / determinant) * adjugate();
         }
 
-        GLA_NODISCARD GLA_CONSTEXPR T trace()
+        GLA_NODISCARD GLA_CONSTEXPR T trace() const
         {
             return values[0][0] + values[1][1] + values[2][2];
         }
 
-        GLA_NODISCARD GLA_CONSTEXPR T determinant()
+        GLA_NODISCARD GLA_CONSTEXPR T determinant() const
         {
-            return values[0][0] * values[1][1] * values[2][2] +
-                   values[1][0] * values[2][1] * values[0][2] +
-                   values[2][0] * values[0][1] * values[1][2] -
+            GLA_INSTRUMENT_COUNT(determinant, mat3x3, T);
 
-                   values[0][2] * values[1][1] * values[2][0] -
-                   values[1][2] * values[2][1] * values[0][0] -
-                   values[2][2] * values[0][1] * values[1][0];
+            return uncounted_determinant();
         }
 
         GLA_NODISCARD GLA_CONSTEXPR mat<2, 2, T> submatrix(std::size_t remove_column, std::size_t remove_row) const
@@ -317,6 +328,69 @@ namespace gla
             return result;
         }
 
+        // ┌----------------------------------------------------┐
+        // │    in-place operations                             |
+        // └----------------------------------------------------┘
+
+        GLA_CONSTEXPR mat & transpose_in_place()
+        {
+            for (int c = 0; c < columns(); c++)
+            {
+                for (int r = c + 1; r < rows(); r++)
+                {
+                    const T value = values[c][r];
+
+                    values[c][r] = values[r][c];
+                    values[r][c] = value;
+                }
+            }
+
+            return *this;
+        }
+
+        GLA_CONSTEXPR mat & cofactor_in_place()
+        {
+            // each cofactor column is the cross product of the other two columns, the third one
+            // only reads the first two, so those are held back until it is written
+            const column first = column::cross(values[1], values[2]);
+            const column second = column::cross(values[2], values[0]);
+
+            values[2] = column::cross(values[0], values[1]);
+            values[0] = first;
+            values[1] = second;
+
+            return *this;
+        }
+
+        GLA_CONSTEXPR mat & adjugate_in_place()
+        {
+            return cofactor_in_place().transpose_in_place();
+        }
+
+        GLA_CONSTEXPR mat & invert_in_place()
+        {
+            GLA_INSTRUMENT_COUNT(inverse, mat3x3, T);
+
+            const T determinant = uncounted_determinant();
+
+            GLA_ASSERT(determinant != 0, "the given mat3x3 is singular, therefore it does not have an inverse!")
+
+            return adjugate_in_place().scale_in_place(1 / determinant);
+        }
+
+        GLA_CONSTEXPR mat & scale_in_place(T scalar)
+        {
+            for (int c = 0; c < columns(); c++)
+            {
+                for (int r = 0; r < rows(); r++)
+                {
+                    values[c][r] *= scalar;
+                }
+            }
+
+            return *this;
+        }
+
         void insert(const float (&values)[3][3])
         {
             for (int c = 0; c < columns(); c++)
@@ -327,5 +401,18 @@ namespace gla
                 }
             }
         }
+
+    private:
+        // determinant() without the instrumentation hook, for the library's own calls
+        GLA_NODISCARD GLA_CONSTEXPR T uncounted_determinant() const
+        {
+            return values[0][0] * values[1][1] * values[2][2] +
+                   values[1][0] * values[2][1] * values[0][2] +
+                   values[2][0] * values[0][1] * values[1][2] -
+
+                   values[0][2] * values[1][1] * values[2][0] -
+                   values[1][2] * values[2][1] * values[0][0] -
+                   values[2][2] * values[0][1] * values[1][0];
+        }
     };
 }
\ No newline at end of file
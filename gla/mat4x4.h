@@ -68,6 +68,8 @@ namespace gla
 
         GLA_NODISCARD GLA_CONSTEXPR mat operator * (const mat &m) const
         {
+            GLA_INSTRUMENT_COUNT(multiply, mat4x4, T);
+
             mat result;
 
             for (int c = 0; c < columns(); c++)
@@ -88,15 +90,17 @@ namespace gla
 
         GLA_NODISCARD GLA_CONSTEXPR mat operator * (T scalar) const
         {
+            mat result;
+
             for (int c = 0; c < columns(); c++)
             {
                 for (int r = 0; r < rows(); r++)
                 {
-                    values[c][r] *= scalar;
+                    result[c][r] = values[c][r] * scalar;
                 }
             }
 
-            return *this;
+            return result;
         }
 
 		GLA_NODISCARD GLA_CONSTEXPR friend mat operator * (T scalar, const mat &m)
@@ -146,6 +150,8 @@ namespace gla
 
         GLA_CONSTEXPR mat & operator *= (const mat &m)
         {
+            GLA_INSTRUMENT_COUNT(multiply, mat4x4, T);
+
             mat result;
 
             for (int c = 0; c < columns(); c++)
@@ -166,6 +172,11 @@ namespace gla
             return *this;
         }
 
+        GLA_CONSTEXPR mat & operator *= (T scalar)
+        {
+            return scale_in_place(scalar);
+        }
+
         // ┌----------------------------------------------------┐
         // │    comparison operators                            |
         // └----------------------------------------------------┘
@@ -225,7 +236,7 @@ namespace gla
             return identity;
         }
 
-        GLA_NODISCARD GLA_CONSTEXPR mat transpose()
+        GLA_NODISCARD GLA_CONSTEXPR mat transpose() const
         {
             mat result;
 
@@ -240,7 +251,7 @@ namespace gla
             return result;
         }
 
-        GLA_NODISCARD GLA_CONSTEXPR mat cofactor()
+        GLA_NODISCARD GLA_CONSTEXPR mat cofactor() const
         {
             mat result;
 
@@ -248,9 +259,7 @@ namespace gla
             {
                 for (int r = 0; r < rows(); r++)
                 {
-                    mat<3, 3, T> minor_matrix = submatrix(c, r);
-
-                    T determinant = minor_matrix.determinant();
+                    const T determinant = minor_determinant(c, r);
 
                     result[c][r] = (((c + r) % 2 == 0) || determinant == 0) ? determinant : -determinant;
                 }
@@ -259,49 +268,32 @@ namespace gla
             return result;
         }
 
-        GLA_NODISCARD GLA_CONSTEXPR mat adjugate()
+        GLA_NODISCARD GLA_CONSTEXPR mat adjugate() const
         {
             return cofactor().transpose();
         }
 
-        GLA_NODISCARD GLA_CONSTEXPR mat inverse()
+        GLA_NODISCARD GLA_CONSTEXPR mat inverse() const
         {
+            GLA_INSTRUMENT_COUNT(inverse, mat4x4, T);
+
+            const T determinant = uncounted_determinant();
+
             GLA_ASSERT(determinant != 0, "the given mat4x4 is singular, therefore it does not have an inverse!")
 
-            return adjugate() * (1 / determinant());
+            return (1 / determinant) * adjugate();
         }
 
-        GLA_NODISCARD GLA_CONSTEXPR T trace()
+        GLA_NODISCARD GLA_CONSTEXPR T trace() const
         {
             return values[0][0] + values[1][1] + values[2][2] + values[3][3];
         }
 
-        GLA_NODISCARD GLA_CONSTEXPR T determinant()
+        GLA_NODISCARD GLA_CONSTEXPR T determinant() const
         {
-            return values[0][0] *
-                   (
-                       values[1][1] * (values[2][2] * values[3][3] - values[2][3] * values[3][2]) -
-                       values[2][1] * (values[1][2] * values[3][3] - values[1][3] * values[3][2]) +
-                       values[3][1] * (values[1][2] * values[2][3] - values[1][3] * values[2][2])
-                   )
-                   - values[1][0] *
-                   (
-                       values[0][1] * (values[2][2] * values[3][3] - values[2][3] * values[3][2]) -
-                       values[2][1] * (values[0][2] * values[3][3] - values[0][3] * values[3][2]) +
-                       values[3][1] * (values[0][2] * values[2][3] - values[0][3] * values[2][2])
-                   )
-                   + values[2][0] *
-                   (
-                       values[0][1] * (values[1][2] * values[3][3] - values[1][3] * values[3][2]) -
-                       values[1][1] * (values[0][2] * values[3][3] - values[0][3] * values[3][2]) +
-                       values[3][1] * (values[0][2] * values[1][3] - values[0][3] * values[1][2])
-                   )
-                   - values[3][0] *
-                   (
-                       values[0][1] * (values[1][2] * values[2][3] - values[1][3] * values[2][2]) -
-                       values[1][1] * (values[0][2] * values[2][3] - values[0][3] * values[2][2]) +
-                       values[2][1] * (values[0][2] * values[1][3] - values[0][3] * values[1][2])
-                   );
+            GLA_INSTRUMENT_COUNT(determinant, mat4x4, T);
+
+            return uncounted_determinant();
         }
 
         GLA_NODISCARD GLA_CONSTEXPR mat<3, 3, T> submatrix(std::size_t remove_column, std::size_t remove_row) const
@@ -335,6 +327,84 @@ namespace gla
             return result;
         }
 
+        // ┌----------------------------------------------------┐
+        // │    in-place operations                             |
+        // └----------------------------------------------------┘
+
+        GLA_CONSTEXPR mat & transpose_in_place()
+        {
+            for (int c = 0; c < columns(); c++)
+            {
+                for (int r = c + 1; r < rows(); r++)
+                {
+                    const T value = values[c][r];
+
+                    values[c][r] = values[r][c];
+                    values[r][c] = value;
+                }
+            }
+
+            return *this;
+        }
+
+        GLA_CONSTEXPR mat & cofactor_in_place()
+        {
+            // 2x2 determinants of every pair of rows in the first and in the last two columns, the minors
+            // of columns 0 and 1 expand over the last pairs, the ones of columns 2 and 3 over the first
+            T low[4][4] = { }, high[4][4] = { };
+
+            for (int i = 0; i < 4; i++)
+            {
+                for (int k = i + 1; k < 4; k++)
+                {
+                    low[i][k] = values[0][i] * values[1][k] - values[0][k] * values[1][i];
+                    high[i][k] = values[2][i] * values[3][k] - values[2][k] * values[3][i];
+                }
+            }
+
+            // columns 0 and 2 are held back while columns 1 and 3 still read them
+            T held[4] = { };
+
+            for (int r = 0; r < 4; r++) held[r] = expand_cofactor(values[1], high, 0, r);
+            for (int r = 0; r < 4; r++) values[1][r] = expand_cofactor(values[0], high, 1, r);
+            for (int r = 0; r < 4; r++) values[0][r] = held[r];
+
+            for (int r = 0; r < 4; r++) held[r] = expand_cofactor(values[3], low, 2, r);
+            for (int r = 0; r < 4; r++) values[3][r] = expand_cofactor(values[2], low, 3, r);
+            for (int r = 0; r < 4; r++) values[2][r] = held[r];
+
+            return *this;
+        }
+
+        GLA_CONSTEXPR mat & adjugate_in_place()
+        {
+            return cofactor_in_place().transpose_in_place();
+        }
+
+        GLA_CONSTEXPR mat & invert_in_place()
+        {
+            GLA_INSTRUMENT_COUNT(inverse, mat4x4, T);
+
+            const T determinant = uncounted_determinant();
+
+            GLA_ASSERT(determinant != 0, "the given mat4x4 is singular, therefore it does not have an inverse!")
+
+            return adjugate_in_place().scale_in_place(1 / determinant);
+        }
+
+        GLA_CONSTEXPR mat & scale_in_place(T scalar)
+        {
+            for (int c = 0; c < columns(); c++)
+            {
+                for (int r = 0; r < rows(); r++)
+                {
+                    values[c][r] *= scalar;
+                }
+            }
+
+            return *this;
+        }
+
         void insert(const float (&values)[4][4])
         {
             for (int c = 0; c < columns(); c++)
@@ -345,5 +415,60 @@ namespace gla
                 }
             }
         }
+
+    private:
+        // determinant() without the instrumentation hook, for the library's own calls
+        GLA_NODISCARD GLA_CONSTEXPR T uncounted_determinant() const
+        {
+            return values[0][0] *
+                   (
+                       values[1][1] * (values[2][2] * values[3][3] - values[2][3] * values[3][2]) -
+                       values[2][1] * (values[1][2] * values[3][3] - values[1][3] * values[3][2]) +
+                       values[3][1] * (values[1][2] * values[2][3] - values[1][3] * values[2][2])
+                   )
+                   - values[1][0] *
+                   (
+                       values[0][1] * (values[2][2] * values[3][3] - values[2][3] * values[3][2]) -
+                       values[2][1] * (values[0][2] * values[3][3] - values[0][3] * values[3][2]) +
+                       values[3][1] * (values[0][2] * values[2][3] - values[0][3] * values[2][2])
+                   )
+                   + values[2][0] *
+                   (
+                       values[0][1] * (values[1][2] * values[3][3] - values[1][3] * values[3][2]) -
+                       values[1][1] * (values[0][2] * values[3][3] - values[0][3] * values[3][2]) +
+                       values[3][1] * (values[0][2] * values[1][3] - values[0][3] * values[1][2])
+                   )
+                   - values[3][0] *
+                   (
+                       values[0][1] * (values[1][2] * values[2][3] - values[1][3] * values[2][2]) -
+                       values[1][1] * (values[0][2] * values[2][3] - values[0][3] * values[2][2]) +
+                       values[2][1] * (values[0][2] * values[1][3] - values[0][3] * values[1][2])
+                   );
+        }
+
+        // determinant of the 3x3 minor without 'column' and 'row', straight from the values
+        GLA_NODISCARD GLA_CONSTEXPR T minor_determinant(int column, int row) const
+        {
+            int c[3] = { }, r[3] = { };
+
+            for (int i = 0, j = 0; i < 4; i++) if (i != column) c[j++] = i;
+            for (int i = 0, j = 0; i < 4; i++) if (i != row) r[j++] = i;
+
+            return values[c[0]][r[0]] * (values[c[1]][r[1]] * values[c[2]][r[2]] - values[c[2]][r[1]] * values[c[1]][r[2]])
+                 - values[c[1]][r[0]] * (values[c[0]][r[1]] * values[c[2]][r[2]] - values[c[2]][r[1]] * values[c[0]][r[2]])
+                 + values[c[2]][r[0]] * (values[c[0]][r[1]] * values[c[1]][r[2]] - values[c[1]][r[1]] * values[c[0]][r[2]]);
+        }
+
+        // cofactor of ('column', 'row') from the column 'x' of its minor and the 2x2 determinants of the minor's other two columns
+        GLA_NODISCARD static GLA_CONSTEXPR T expand_cofactor(const vec<4, T> &x, const T (&pairs)[4][4], int column, int row)
+        {
+            int r[3] = { };
+
+            for (int i = 0, j = 0; i < 4; i++) if (i != row) r[j++] = i;
+
+            const T determinant = x[r[0]] * pairs[r[1]][r[2]] - x[r[1]] * pairs[r[0]][r[2]] + x[r[2]] * pairs[r[0]][r[1]];
+
+            return (((column + row) % 2 == 0) || determinant == 0) ? determinant : -determinant;
+        }
     };
 }
\ No newline at end of file
@@ -7,6 +7,9 @@
     | all matrices are in column-major order |
     |                                        |
     | matrix[column][row]                    |
+    |                                        |
+    | row-major storage for uploads lives in |
+    | matrix_layout.h                        |
     └----------------------------------------┘
 
     ┌----------------------------------------┐
@@ -20,6 +23,14 @@
     | [x] trace                              |
     | [x] determinant                        |
     | [x] submatrix                          |
+    |                                        |
+    | in-place variants:                     |
+    |                                        |
+    | [x] transpose_in_place                 |
+    | [x] cofactor_in_place                  |
+    | [x] adjugate_in_place                  |
+    | [x] invert_in_place                    |
+    | [x] scale_in_place                     |
     └----------------------------------------┘
 */
 
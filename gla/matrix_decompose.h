@@ -0,0 +1,191 @@
+#pragma once
+
+#include "gla.h"
+
+/*
+    ┌--------------------------------------------------------------------------┐
+    |                                                                          |
+    | decomposition of affine mat4x4 transforms:                               |
+    |                                                                          |
+    |        matrix = translation * rotation * shear * scale                   |
+    |                                                                          |
+    | the shear is upper triangular and only recovered on request:             |
+    |                                                                          |
+    |        | 1  xy  xz |                                                     |
+    |        | 0  1   yz |                                                     |
+    |        | 0  0   1  |                                                     |
+    |                                                                          |
+    | a mirrored matrix (negative determinant) comes back with a negative      |
+    | x scale, so the rotation is always proper.                               |
+    |                                                                          |
+    | quaternions are stored in a vec4 as { x, y, z, w }                       |
+    |                                                                          |
+    └--------------------------------------------------------------------------┘
+*/
+
+namespace gla
+{
+    template<typename T>
+    struct transform_components
+    {
+        vec<3, T> translation;
+        mat<3, 3, T> rotation;
+        vec<3, T> scale;
+
+        // { xy, xz, yz }, zero unless decomposed with 'shear'
+        vec<3, T> shear;
+    };
+
+    // quaternion of a proper rotation matrix
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR vec<4, T> quaternion(const mat<3, 3, T> &rotation)
+    {
+        const T trace = rotation[0][0] + rotation[1][1] + rotation[2][2];
+
+        // pick the largest diagonal term to divide by, so that the square root never gets close to zero
+        if (trace > 0)
+        {
+            const T s = std::sqrt(trace + 1) * 2;
+
+            return { (rotation[1][2] - rotation[2][1]) / s, (rotation[2][0] - rotation[0][2]) / s, (rotation[0][1] - rotation[1][0]) / s, s / 4 };
+        }
+
+        if (rotation[0][0] > rotation[1][1] && rotation[0][0] > rotation[2][2])
+        {
+            const T s = std::sqrt(1 + rotation[0][0] - rotation[1][1] - rotation[2][2]) * 2;
+
+            return { s / 4, (rotation[1][0] + rotation[0][1]) / s, (rotation[2][0] + rotation[0][2]) / s, (rotation[1][2] - rotation[2][1]) / s };
+        }
+
+        if (rotation[1][1] > rotation[2][2])
+        {
+            const T s = std::sqrt(1 + rotation[1][1] - rotation[0][0] - rotation[2][2]) * 2;
+
+            return { (rotation[1][0] + rotation[0][1]) / s, s / 4, (rotation[2][1] + rotation[1][2]) / s, (rotation[2][0] - rotation[0][2]) / s };
+        }
+
+        const T s = std::sqrt(1 + rotation[2][2] - rotation[0][0] - rotation[1][1]) * 2;
+
+        return { (rotation[2][0] + rotation[0][2]) / s, (rotation[2][1] + rotation[1][2]) / s, s / 4, (rotation[0][1] - rotation[1][0]) / s };
+    }
+
+    // rotation matrix of a unit quaternion
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR mat<3, 3, T> rotation_matrix(const vec<4, T> &q)
+    {
+        const T xx = q.x * q.x, yy = q.y * q.y, zz = q.z * q.z;
+        const T xy = q.x * q.y, xz = q.x * q.z, yz = q.y * q.z;
+        const T wx = q.w * q.x, wy = q.w * q.y, wz = q.w * q.z;
+
+        return
+        {
+            1 - 2 * (yy + zz),     2 * (xy + wz),     2 * (xz - wy),
+                2 * (xy - wz), 1 - 2 * (xx + zz),     2 * (yz + wx),
+                2 * (xz + wy),     2 * (yz - wx), 1 - 2 * (xx + yy)
+        };
+    }
+
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR transform_components<T> decompose(const mat<4, 4, T> &matrix, bool shear = false)
+    {
+        GLA_STATIC_ASSERT(std::is_floating_point<T>::value, "function 'decompose()' only accepts floating-point value inputs!");
+
+        transform_components<T> result;
+
+        result.translation = { matrix[3][0], matrix[3][1], matrix[3][2] };
+
+        vec<3, T> x(matrix[0][0], matrix[0][1], matrix[0][2]);
+        vec<3, T> y(matrix[1][0], matrix[1][1], matrix[1][2]);
+        vec<3, T> z(matrix[2][0], matrix[2][1], matrix[2][2]);
+
+        result.scale.x = x.length();
+
+        GLA_ASSERT(result.scale.x != 0, "the given mat4x4 has a zero scale, therefore it can not be decomposed!")
+
+        x /= result.scale.x;
+
+        if (shear)
+        {
+            // gram-schmidt, keeping the projections as shear factors
+            result.shear.x = vec<3, T>::dot(x, y);
+            y -= x * result.shear.x;
+
+            result.scale.y = y.length();
+
+            GLA_ASSERT(result.scale.y != 0, "the given mat4x4 has a zero scale, therefore it can not be decomposed!")
+
+            y /= result.scale.y;
+            result.shear.x /= result.scale.y;
+
+            result.shear.y = vec<3, T>::dot(x, z);
+            z -= x * result.shear.y;
+
+            result.shear.z = vec<3, T>::dot(y, z);
+            z -= y * result.shear.z;
+
+            result.scale.z = z.length();
+
+            GLA_ASSERT(result.scale.z != 0, "the given mat4x4 has a zero scale, therefore it can not be decomposed!")
+
+            z /= result.scale.z;
+            result.shear.y /= result.scale.z;
+            result.shear.z /= result.scale.z;
+        }
+        else
+        {
+            result.scale.y = y.length();
+            result.scale.z = z.length();
+
+            GLA_ASSERT(result.scale.y != 0 && result.scale.z != 0, "the given mat4x4 has a zero scale, therefore it can not be decomposed!")
+
+            y /= result.scale.y;
+            z /= result.scale.z;
+        }
+
+        // mirrored, move the reflection into the x scale
+        if (vec<3, T>::dot(x, vec<3, T>::cross(y, z)) < 0)
+        {
+            x = x.opposite();
+
+            result.scale.x = - result.scale.x;
+            result.shear.x = - result.shear.x;
+            result.shear.y = - result.shear.y;
+        }
+
+        result.rotation = { x, y, z };
+
+        return result;
+    }
+
+    // decomposes 'count' affine matrices
+    template<typename T>
+    static void decompose(const mat<4, 4, T> *matrices, std::size_t count, transform_components<T> *output, bool shear = false)
+    {
+        GLA_INSTRUMENT_KERNEL("decompose", count);
+
+        for (std::size_t i = 0; i < count; i++)
+        {
+            output[i] = decompose(matrices[i], shear);
+        }
+    }
+
+    // inverse of decompose()
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR mat<4, 4, T> compose(const transform_components<T> &components)
+    {
+        const mat<3, 3, T> &r = components.rotation;
+
+        const vec<3, T> x = r[0] * components.scale.x;
+        const vec<3, T> y = (r[1] + r[0] * components.shear.x) * components.scale.y;
+        const vec<3, T> z = (r[2] + r[0] * components.shear.y + r[1] * components.shear.z) * components.scale.z;
+
+        return
+        {
+            x.x, x.y, x.z, 0,
+            y.x, y.y, y.z, 0,
+            z.x, z.y, z.z, 0,
+
+            components.translation.x, components.translation.y, components.translation.z, 1
+        };
+    }
+}
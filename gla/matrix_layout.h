@@ -0,0 +1,290 @@
+#pragma once
+
+#include <cstring>
+
+#include "gla.h"
+
+/*
+    ┌--------------------------------------------------------------------------┐
+    |                                                                          |
+    | matrices in a selectable storage layout, for apis that expect rows:      |
+    |                                                                          |
+    |   stored_mat<L, C, R, T> has the math api of mat<C, R, T>, addressed     |
+    |   as (column, row) whatever the layout, but keeps its values in 'L'.     |
+    |   a row-major matrix is held as the column-major mat of its transpose,   |
+    |   so the math runs on the mat kernels with the operands swapped:         |
+    |                                                                          |
+    |        a * b             =  transpose(b) * transpose(a)  in storage      |
+    |        inverse(a)        =  inverse(transpose(a))        in storage      |
+    |        determinant(a)    =  determinant(transpose(a))                    |
+    |                                                                          |
+    |   products, inverses and uploads therefore never transpose. only the     |
+    |   conversions from and to mat<C, R, T> do, at the edges.                 |
+    |                                                                          |
+    |   - data() is the flat array in 'L', ready for the api                   |
+    |   - store(matrices, count, output) uploads many of them back to back     |
+    |                                                                          |
+    | GLA_USE_ROW_MAJOR_STORAGE picks the layout of default_layout_mat.        |
+    |                                                                          |
+    └--------------------------------------------------------------------------┘
+*/
+
+namespace gla
+{
+    enum class layout
+    {
+        column_major,
+        row_major
+    };
+
+#if GLA_USE_ROW_MAJOR_STORAGE
+    static GLA_CONSTEXPR const layout DEFAULT_LAYOUT = layout::row_major;
+#else
+    static GLA_CONSTEXPR const layout DEFAULT_LAYOUT = layout::column_major;
+#endif
+
+    // ┌----------------------------------------------------┐
+    // │    raw access                                      |
+    // └----------------------------------------------------┘
+
+    // the column-major values of 'm', contiguous
+    template<std::size_t C, std::size_t R, typename T>
+    GLA_NODISCARD static const T * data(const mat<C, R, T> &m)
+    {
+        GLA_STATIC_ASSERT(sizeof(mat<C, R, T>) == C * R * sizeof(T), "a matrix must be tightly packed to be read as a flat array!");
+
+        return &m[0][0];
+    }
+
+    template<std::size_t C, std::size_t R, typename T>
+    GLA_NODISCARD static T * data(mat<C, R, T> &m)
+    {
+        GLA_STATIC_ASSERT(sizeof(mat<C, R, T>) == C * R * sizeof(T), "a matrix must be tightly packed to be read as a flat array!");
+
+        return &m[0][0];
+    }
+
+    // ┌----------------------------------------------------┐
+    // │    stored matrices                                 |
+    // └----------------------------------------------------┘
+
+    template<layout L, std::size_t C, std::size_t R, typename T>
+    struct stored_mat
+    {
+        typedef mat<C, R, T> matrix;
+
+        // the column-major mat whose memory is this layout, the transpose for rows
+        typedef typename std::conditional<L == layout::row_major, mat<R, C, T>, mat<C, R, T>>::type storage;
+
+        GLA_NODISCARD static GLA_CONSTEXPR const std::size_t columns() { return C; };
+        GLA_NODISCARD static GLA_CONSTEXPR const std::size_t rows() { return R; };
+
+    private:
+        storage values;
+
+        GLA_CONSTEXPR explicit stored_mat(const storage &values, int) : values(values) { }
+
+        GLA_NODISCARD static GLA_CONSTEXPR stored_mat from_storage(const storage &values)
+        {
+            return stored_mat(values, 0);
+        }
+
+        template<layout, std::size_t, std::size_t, typename> friend struct stored_mat;
+
+    public:
+        // ┌----------------------------------------------------┐
+        // │    constructors                                    |
+        // └----------------------------------------------------┘
+
+        GLA_CONSTEXPR stored_mat() : values() { }
+
+        // converts from the column-major math type, a transpose for rows
+        GLA_CONSTEXPR explicit stored_mat(const matrix &m) : values()
+        {
+            for (std::size_t c = 0; c < C; c++)
+            {
+                for (std::size_t r = 0; r < R; r++)
+                {
+                    (*this)(c, r) = m[c][r];
+                }
+            }
+        }
+
+        // ┌----------------------------------------------------┐
+        // │    binary operators                                |
+        // └----------------------------------------------------┘
+
+        GLA_NODISCARD GLA_CONSTEXPR stored_mat operator + (const stored_mat &m) const
+        {
+            return from_storage(values + m.values);
+        }
+
+        GLA_NODISCARD GLA_CONSTEXPR stored_mat operator - (const stored_mat &m) const
+        {
+            return from_storage(values - m.values);
+        }
+
+        // the mat kernel on the storage, with the operands swapped for rows
+        template<std::size_t K>
+        GLA_NODISCARD GLA_CONSTEXPR stored_mat<L, K, R, T> operator * (const stored_mat<L, K, C, T> &m) const
+        {
+            return stored_mat<L, K, R, T>::from_storage((L == layout::row_major) ? m.values * values : values * m.values);
+        }
+
+        GLA_NODISCARD GLA_CONSTEXPR stored_mat operator * (T scalar) const
+        {
+            return from_storage(values * scalar);
+        }
+
+        GLA_NODISCARD GLA_CONSTEXPR friend stored_mat operator * (T scalar, const stored_mat &m)
+        {
+            return from_storage(m.values * scalar);
+        }
+
+        // ┌----------------------------------------------------┐
+        // │    compound assignment operators                   |
+        // └----------------------------------------------------┘
+
+        GLA_CONSTEXPR stored_mat & operator += (const stored_mat &m)
+        {
+            values += m.values;
+
+            return *this;
+        }
+
+        GLA_CONSTEXPR stored_mat & operator -= (const stored_mat &m)
+        {
+            values -= m.values;
+
+            return *this;
+        }
+
+        GLA_CONSTEXPR stored_mat & operator *= (const stored_mat &m)
+        {
+            values = (L == layout::row_major) ? m.values * values : values * m.values;
+
+            return *this;
+        }
+
+        GLA_CONSTEXPR stored_mat & operator *= (T scalar)
+        {
+            values *= scalar;
+
+            return *this;
+        }
+
+        // ┌----------------------------------------------------┐
+        // │    comparison operators                            |
+        // └----------------------------------------------------┘
+
+        GLA_NODISCARD GLA_CONSTEXPR bool operator == (const stored_mat &m) const
+        {
+            return values == m.values;
+        }
+
+        GLA_NODISCARD GLA_CONSTEXPR bool operator != (const stored_mat &m) const
+        {
+            return !(*this == m);
+        }
+
+        // ┌----------------------------------------------------┐
+        // │    access operators                                |
+        // └----------------------------------------------------┘
+
+        GLA_NODISCARD GLA_CONSTEXPR T & operator () (std::size_t column, std::size_t row)
+        {
+            GLA_ASSERT(column < C && row < R, "trying to access or write to a non-existent stored matrix index!")
+
+            return (L == layout::row_major) ? values[row][column] : values[column][row];
+        }
+
+        GLA_NODISCARD GLA_CONSTEXPR const T & operator () (std::size_t column, std::size_t row) const
+        {
+            GLA_ASSERT(column < C && row < R, "trying to access or write to a non-existent stored matrix index!")
+
+            return (L == layout::row_major) ? values[row][column] : values[column][row];
+        }
+
+        // ┌----------------------------------------------------┐
+        // │    properties                                      |
+        // └----------------------------------------------------┘
+
+        GLA_NODISCARD const T * data() const { return gla::data(values); }
+        GLA_NODISCARD T * data() { return gla::data(values); }
+
+        GLA_NODISCARD static GLA_CONSTEXPR stored_mat identity()
+        {
+            return from_storage(storage::identity());
+        }
+
+        GLA_NODISCARD GLA_CONSTEXPR stored_mat<L, R, C, T> transpose() const
+        {
+            return stored_mat<L, R, C, T>::from_storage(values.transpose());
+        }
+
+        GLA_NODISCARD GLA_CONSTEXPR stored_mat inverse() const
+        {
+            return from_storage(values.inverse());
+        }
+
+        GLA_NODISCARD GLA_CONSTEXPR T trace() const
+        {
+            return values.trace();
+        }
+
+        GLA_NODISCARD GLA_CONSTEXPR T determinant() const
+        {
+            return values.determinant();
+        }
+
+        // converts back to the column-major math type, a transpose for rows
+        GLA_NODISCARD GLA_CONSTEXPR matrix to_mat() const
+        {
+            matrix result;
+
+            for (std::size_t c = 0; c < C; c++)
+            {
+                for (std::size_t r = 0; r < R; r++)
+                {
+                    result[c][r] = (*this)(c, r);
+                }
+            }
+
+            return result;
+        }
+    };
+
+    template<std::size_t C, std::size_t R, typename T> using row_major_mat = stored_mat<layout::row_major, C, R, T>;
+    template<std::size_t C, std::size_t R, typename T> using column_major_mat = stored_mat<layout::column_major, C, R, T>;
+    template<std::size_t C, std::size_t R, typename T> using default_layout_mat = stored_mat<DEFAULT_LAYOUT, C, R, T>;
+
+    // ┌----------------------------------------------------┐
+    // │    batched stores                                  |
+    // └----------------------------------------------------┘
+
+    // writes 'count' matrices back to back into 'output', C * R values each in their own layout
+    template<layout L, std::size_t C, std::size_t R, typename T>
+    static void store(const stored_mat<L, C, R, T> *matrices, std::size_t count, T *output)
+    {
+        GLA_STATIC_ASSERT(sizeof(stored_mat<L, C, R, T>) == C * R * sizeof(T), "a stored matrix must be tightly packed to be stored as a flat array!");
+
+        GLA_INSTRUMENT_KERNEL("store", count);
+
+        if (count == 0) return;
+
+        std::memcpy(output, matrices[0].data(), count * sizeof(stored_mat<L, C, R, T>));
+    }
+
+    // the math types are column-major already
+    template<std::size_t C, std::size_t R, typename T>
+    static void store(const mat<C, R, T> *matrices, std::size_t count, T *output)
+    {
+        GLA_STATIC_ASSERT(sizeof(mat<C, R, T>) == C * R * sizeof(T), "a matrix must be tightly packed to be stored as a flat array!");
+
+        GLA_INSTRUMENT_KERNEL("store", count);
+
+        if (count == 0) return;
+
+        std::memcpy(output, data(matrices[0]), count * sizeof(mat<C, R, T>));
+    }
+}
@@ -0,0 +1,390 @@
+#pragma once
+
+#include "gla.h"
+
+/*
+    ┌--------------------------------------------------------------------------┐
+    |                                                                          |
+    | mat4x4 wrappers tagged with what is known about them at compile time:    |
+    |                                                                          |
+    |        general_tag                                                       |
+    |          └ affine_tag        bottom row is [ 0 0 0 1 ]                   |
+    |              ├ rigid_tag     rotation and translation                    |
+    |              |   └ rotation_tag                                          |
+    |              └ scale_tag     diagonal                                    |
+    |                                                                          |
+    | products, inverses and transforms pick the cheapest kernel for their     |
+    | tags by overload resolution, e.g. a rigid inverse is a transpose plus    |
+    | a rotated translation, and scale times matrix is a row scale.            |
+    |                                                                          |
+    | a tag is a promise made by whoever builds the matrix, it is never        |
+    | checked. tagged matrices widen implicitly (rotation -> rigid -> affine   |
+    | -> general) and convert to a plain mat4x4.                               |
+    |                                                                          |
+    └--------------------------------------------------------------------------┘
+*/
+
+namespace gla
+{
+    struct general_tag { };
+    struct affine_tag : general_tag { };
+    struct rigid_tag : affine_tag { };
+    struct rotation_tag : rigid_tag { };
+    struct scale_tag : affine_tag { };
+
+    // the tightest tag that the product of an 'A' and a 'B' is guaranteed to keep
+    template<typename A, typename B>
+    struct product_tag
+    {
+        typedef typename std::conditional<std::is_base_of<rotation_tag, A>::value && std::is_base_of<rotation_tag, B>::value, rotation_tag,
+                typename std::conditional<std::is_base_of<rigid_tag, A>::value && std::is_base_of<rigid_tag, B>::value, rigid_tag,
+                typename std::conditional<std::is_base_of<scale_tag, A>::value && std::is_base_of<scale_tag, B>::value, scale_tag,
+                typename std::conditional<std::is_base_of<affine_tag, A>::value && std::is_base_of<affine_tag, B>::value, affine_tag,
+                                          general_tag>::type>::type>::type>::type type;
+    };
+
+    template<typename K, typename T>
+    struct tagged_mat
+    {
+        typedef K tag;
+        typedef mat<4, 4, T> matrix;
+        typedef vec<4, T> column;
+
+        matrix value;
+
+        // ┌----------------------------------------------------┐
+        // │    constructors                                    |
+        // └----------------------------------------------------┘
+
+        GLA_CONSTEXPR tagged_mat() : value(matrix::identity()) { }
+
+        // trusts the caller that 'm' really is of kind 'K'
+        GLA_CONSTEXPR explicit tagged_mat(const matrix &m) : value(m) { }
+
+        // widening, e.g. rigid to affine
+        template<typename F, typename = typename std::enable_if<std::is_base_of<K, F>::value>::type>
+        GLA_CONSTEXPR tagged_mat(const tagged_mat<F, T> &m) : value(m.value) { }
+
+        // ┌----------------------------------------------------┐
+        // │    access operators                                |
+        // └----------------------------------------------------┘
+
+        GLA_NODISCARD GLA_CONSTEXPR const column & operator [] (std::size_t index) const
+        {
+            return value[index];
+        }
+
+        GLA_NODISCARD GLA_CONSTEXPR operator const matrix & () const
+        {
+            return value;
+        }
+    };
+
+    template<typename T> using general_mat  = tagged_mat<general_tag, T>;
+    template<typename T> using affine_mat   = tagged_mat<affine_tag, T>;
+    template<typename T> using rigid_mat    = tagged_mat<rigid_tag, T>;
+    template<typename T> using rotation_mat = tagged_mat<rotation_tag, T>;
+    template<typename T> using scale_mat    = tagged_mat<scale_tag, T>;
+
+    typedef general_mat<float>      general4x4;
+    typedef affine_mat<float>       affine4x4;
+    typedef rigid_mat<float>        rigid4x4;
+    typedef rotation_mat<float>     rotation4x4;
+    typedef scale_mat<float>        scale4x4;
+
+    // ┌----------------------------------------------------┐
+    // │    factories                                       |
+    // └----------------------------------------------------┘
+
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR rigid_mat<T> make_translation(const vec<3, T> &offset)
+    {
+        return rigid_mat<T>(translate(mat<4, 4, T>::identity(), offset));
+    }
+
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR rotation_mat<T> make_rotation_x(T angle)
+    {
+        return rotation_mat<T>(rotate_x(mat<4, 4, T>::identity(), angle));
+    }
+
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR rotation_mat<T> make_rotation_y(T angle)
+    {
+        return rotation_mat<T>(rotate_y(mat<4, 4, T>::identity(), angle));
+    }
+
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR rotation_mat<T> make_rotation_z(T angle)
+    {
+        return rotation_mat<T>(rotate_z(mat<4, 4, T>::identity(), angle));
+    }
+
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR scale_mat<T> make_scale(const vec<3, T> &factor)
+    {
+        return scale_mat<T>(scale(mat<4, 4, T>::identity(), factor));
+    }
+
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR rigid_mat<T> make_view(const vec<3, T> &eye, const vec<3, T> &at, const vec<3, T> &up)
+    {
+        return rigid_mat<T>(view(eye, at, up));
+    }
+
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR affine_mat<T> make_orthographic(T left, T right, T bottom, T top, T near, T far)
+    {
+        return affine_mat<T>(orthographic(left, right, bottom, top, near, far));
+    }
+
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR general_mat<T> make_perspective(T fov_degrees, T aspect_ratio, T near, T far)
+    {
+        return general_mat<T>(perspective(fov_degrees, aspect_ratio, near, far));
+    }
+
+    // ┌----------------------------------------------------┐
+    // │    multiplication kernels                          |
+    // └----------------------------------------------------┘
+
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR mat<4, 4, T> tagged_multiply(const mat<4, 4, T> &a, const mat<4, 4, T> &b, general_tag, general_tag)
+    {
+        return a * b;
+    }
+
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR mat<4, 4, T> tagged_multiply(const mat<4, 4, T> &a, const mat<4, 4, T> &b, affine_tag, affine_tag)
+    {
+        return affine_multiply(a, b);
+    }
+
+    // upper 3x3 only
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR mat<4, 4, T> tagged_multiply(const mat<4, 4, T> &a, const mat<4, 4, T> &b, rotation_tag, rotation_tag)
+    {
+        mat<4, 4, T> result;
+
+        for (int c = 0; c < 3; c++)
+        {
+            for (int r = 0; r < 3; r++)
+            {
+                result[c][r] = a[0][r] * b[c][0] + a[1][r] * b[c][1] + a[2][r] * b[c][2];
+            }
+        }
+
+        result[3][3] = 1;
+
+        return result;
+    }
+
+    // diagonal only
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR mat<4, 4, T> tagged_multiply(const mat<4, 4, T> &a, const mat<4, 4, T> &b, scale_tag, scale_tag)
+    {
+        mat<4, 4, T> result;
+
+        result[0][0] = a[0][0] * b[0][0];
+        result[1][1] = a[1][1] * b[1][1];
+        result[2][2] = a[2][2] * b[2][2];
+        result[3][3] = 1;
+
+        return result;
+    }
+
+    // scale on the left scales the first three rows
+    template<typename T, typename B>
+    GLA_NODISCARD static GLA_CONSTEXPR mat<4, 4, T> tagged_multiply(const mat<4, 4, T> &a, const mat<4, 4, T> &b, scale_tag, B)
+    {
+        mat<4, 4, T> result = b;
+
+        for (int c = 0; c < 4; c++)
+        {
+            result[c][0] *= a[0][0];
+            result[c][1] *= a[1][1];
+            result[c][2] *= a[2][2];
+        }
+
+        return result;
+    }
+
+    // scale on the right scales the first three columns
+    template<typename T, typename A>
+    GLA_NODISCARD static GLA_CONSTEXPR mat<4, 4, T> tagged_multiply(const mat<4, 4, T> &a, const mat<4, 4, T> &b, A, scale_tag)
+    {
+        mat<4, 4, T> result = a;
+
+        result[0] *= b[0][0];
+        result[1] *= b[1][1];
+        result[2] *= b[2][2];
+
+        return result;
+    }
+
+    template<typename A, typename B, typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR tagged_mat<typename product_tag<A, B>::type, T> operator * (const tagged_mat<A, T> &a, const tagged_mat<B, T> &b)
+    {
+        return tagged_mat<typename product_tag<A, B>::type, T>(tagged_multiply(a.value, b.value, A(), B()));
+    }
+
+    // ┌----------------------------------------------------┐
+    // │    inverse kernels                                 |
+    // └----------------------------------------------------┘
+
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR mat<4, 4, T> tagged_inverse(const mat<4, 4, T> &m, general_tag)
+    {
+        return m.inverse();
+    }
+
+    // inverse of the upper 3x3 via its adjugate, then the translation rotated back
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR mat<4, 4, T> tagged_inverse(const mat<4, 4, T> &m, affine_tag)
+    {
+        const vec<3, T> a0(m[0][0], m[0][1], m[0][2]);
+        const vec<3, T> a1(m[1][0], m[1][1], m[1][2]);
+        const vec<3, T> a2(m[2][0], m[2][1], m[2][2]);
+
+        // rows of the inverse
+        vec<3, T> r0 = vec<3, T>::cross(a1, a2);
+        vec<3, T> r1 = vec<3, T>::cross(a2, a0);
+        vec<3, T> r2 = vec<3, T>::cross(a0, a1);
+
+        const T determinant = vec<3, T>::dot(a0, r0);
+
+        GLA_ASSERT(determinant != 0, "the given affine mat4x4 is singular, therefore it does not have an inverse!")
+
+        const T inverse_determinant = 1 / determinant;
+
+        r0 *= inverse_determinant;
+        r1 *= inverse_determinant;
+        r2 *= inverse_determinant;
+
+        const vec<3, T> t(m[3][0], m[3][1], m[3][2]);
+
+        return
+        {
+            r0.x, r1.x, r2.x, 0,
+            r0.y, r1.y, r2.y, 0,
+            r0.z, r1.z, r2.z, 0,
+
+            - vec<3, T>::dot(r0, t), - vec<3, T>::dot(r1, t), - vec<3, T>::dot(r2, t), 1
+        };
+    }
+
+    // transpose of the rotation, translation rotated back
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR mat<4, 4, T> tagged_inverse(const mat<4, 4, T> &m, rigid_tag)
+    {
+        const T tx = m[3][0], ty = m[3][1], tz = m[3][2];
+
+        return
+        {
+            m[0][0], m[1][0], m[2][0], 0,
+            m[0][1], m[1][1], m[2][1], 0,
+            m[0][2], m[1][2], m[2][2], 0,
+
+            - (m[0][0] * tx + m[0][1] * ty + m[0][2] * tz),
+            - (m[1][0] * tx + m[1][1] * ty + m[1][2] * tz),
+            - (m[2][0] * tx + m[2][1] * ty + m[2][2] * tz), 1
+        };
+    }
+
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR mat<4, 4, T> tagged_inverse(const mat<4, 4, T> &m, rotation_tag)
+    {
+        return
+        {
+            m[0][0], m[1][0], m[2][0], 0,
+            m[0][1], m[1][1], m[2][1], 0,
+            m[0][2], m[1][2], m[2][2], 0,
+
+            0, 0, 0, 1
+        };
+    }
+
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR mat<4, 4, T> tagged_inverse(const mat<4, 4, T> &m, scale_tag)
+    {
+        GLA_ASSERT(m[0][0] != 0 && m[1][1] != 0 && m[2][2] != 0, "the given scale mat4x4 is singular, therefore it does not have an inverse!")
+
+        mat<4, 4, T> result;
+
+        result[0][0] = 1 / m[0][0];
+        result[1][1] = 1 / m[1][1];
+        result[2][2] = 1 / m[2][2];
+        result[3][3] = 1;
+
+        return result;
+    }
+
+    template<typename K, typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR tagged_mat<K, T> inverse(const tagged_mat<K, T> &m)
+    {
+        return tagged_mat<K, T>(tagged_inverse(m.value, K()));
+    }
+
+    // ┌----------------------------------------------------┐
+    // │    transform kernels                               |
+    // └----------------------------------------------------┘
+
+    // full product, followed by the perspective divide
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR vec<3, T> tagged_transform_point(const mat<4, 4, T> &m, const vec<3, T> &p, general_tag)
+    {
+        const vec<4, T> result = m[0] * p.x + m[1] * p.y + m[2] * p.z + m[3];
+
+        return vec<3, T>(result.x, result.y, result.z) / result.w;
+    }
+
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR vec<3, T> tagged_transform_point(const mat<4, 4, T> &m, const vec<3, T> &p, affine_tag)
+    {
+        return
+        {
+            m[0][0] * p.x + m[1][0] * p.y + m[2][0] * p.z + m[3][0],
+            m[0][1] * p.x + m[1][1] * p.y + m[2][1] * p.z + m[3][1],
+            m[0][2] * p.x + m[1][2] * p.y + m[2][2] * p.z + m[3][2]
+        };
+    }
+
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR vec<3, T> tagged_transform_point(const mat<4, 4, T> &m, const vec<3, T> &p, scale_tag)
+    {
+        return { m[0][0] * p.x, m[1][1] * p.y, m[2][2] * p.z };
+    }
+
+    // directions skip the translation, so only the upper 3x3 is read
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR vec<3, T> tagged_transform_vector(const mat<4, 4, T> &m, const vec<3, T> &v, affine_tag)
+    {
+        return
+        {
+            m[0][0] * v.x + m[1][0] * v.y + m[2][0] * v.z,
+            m[0][1] * v.x + m[1][1] * v.y + m[2][1] * v.z,
+            m[0][2] * v.x + m[1][2] * v.y + m[2][2] * v.z
+        };
+    }
+
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR vec<3, T> tagged_transform_vector(const mat<4, 4, T> &m, const vec<3, T> &v, scale_tag)
+    {
+        return { m[0][0] * v.x, m[1][1] * v.y, m[2][2] * v.z };
+    }
+
+    template<typename K, typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR vec<3, T> transform_point(const tagged_mat<K, T> &m, const vec<3, T> &p)
+    {
+        return tagged_transform_point(m.value, p, K());
+    }
+
+    // only defined for affine kinds, a general matrix has no meaningful direction transform
+    template<typename K, typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR vec<3, T> transform_vector(const tagged_mat<K, T> &m, const vec<3, T> &v)
+    {
+        GLA_STATIC_ASSERT((std::is_base_of<affine_tag, K>::value), "function 'transform_vector()' only accepts affine matrices!");
+
+        return tagged_transform_vector(m.value, v, K());
+    }
+}
@@ -39,7 +39,7 @@ namespace gla
     template<typename T>
     GLA_NODISCARD GLA_CONSTEXPR mat<4, 4, T> rotate_x(const mat<4, 4, T> &input, T angle)
     {
-        mat<4, 4, T> result = mat4x4::identity();
+        mat<4, 4, T> result = mat<4, 4, T>::identity();
 
         result[1][1] =   std::cos(angle);
         result[1][2] =   std::sin(angle);
@@ -52,7 +52,7 @@ namespace gla
     template<typename T>
     GLA_NODISCARD GLA_CONSTEXPR mat<4, 4, T> rotate_y(const mat<4, 4, T> &input, T angle)
     {
-        mat<4, 4, T> result = mat4x4::identity();
+        mat<4, 4, T> result = mat<4, 4, T>::identity();
 
         result[0][0] =   std::cos(angle);
         result[0][2] = - std::sin(angle);
@@ -65,7 +65,7 @@ namespace gla
     template<typename T>
     GLA_NODISCARD GLA_CONSTEXPR mat<4, 4, T> rotate_z(const mat<4, 4, T> &input, T angle)
     {
-        mat<4, 4, T> result = mat4x4::identity();
+        mat<4, 4, T> result = mat<4, 4, T>::identity();
 
         result[0][0] =   std::cos(angle);
         result[0][1] =   std::sin(angle);
@@ -91,7 +91,7 @@ namespace gla
     template<typename T>
     GLA_NODISCARD static GLA_CONSTEXPR mat<4, 4, T> view(const vec<3, T> &eye, const vec<3, T> &at, const vec<3, T> &up)
     {
-        mat<4, 4, T> view = gla::mat4x4::identity();
+        mat<4, 4, T> view = mat<4, 4, T>::identity();
 
         const vec<3, T> front = (at - eye).normalized();
         const vec<3, T> side  = vec<3, T>::cross(front, up).normalized();
@@ -137,7 +137,7 @@ namespace gla
     template<typename T>
     GLA_NODISCARD static GLA_CONSTEXPR mat<4, 4, T> orthographic(T left, T right, T bottom, T top, T near, T far)
     {
-        mat<4, 4, T> projection = gla::mat4x4::identity();
+        mat<4, 4, T> projection = mat<4, 4, T>::identity();
 
         projection[0][0] =   2 / (right - left);
         projection[1][1] =   2 / (top - bottom);
@@ -148,4 +148,89 @@ namespace gla
 
         return projection;
     }
+
+    // 'a * b' for affine matrices, the bottom rows are taken as [ 0 0 0 1 ] - 36 multiplications instead of 64
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR mat<4, 4, T> affine_multiply(const mat<4, 4, T> &a, const mat<4, 4, T> &b)
+    {
+        mat<4, 4, T> result;
+
+        for (int c = 0; c < 4; c++)
+        {
+            for (int r = 0; r < 3; r++)
+            {
+                result[c][r] = a[0][r] * b[c][0] + a[1][r] * b[c][1] + a[2][r] * b[c][2];
+            }
+        }
+
+        result[3][0] += a[3][0];
+        result[3][1] += a[3][1];
+        result[3][2] += a[3][2];
+        result[3][3] = 1;
+
+        return result;
+    }
+
+    // normal matrix - inverse-transpose of the upper 3x3, via the adjugate: [ a1 x a2, a2 x a0, a0 x a1 ] / det
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR mat<3, 3, T> normal_matrix(const mat<4, 4, T> &model)
+    {
+        const vec<3, T> a0(model[0][0], model[0][1], model[0][2]);
+        const vec<3, T> a1(model[1][0], model[1][1], model[1][2]);
+        const vec<3, T> a2(model[2][0], model[2][1], model[2][2]);
+
+        const vec<3, T> c0 = vec<3, T>::cross(a1, a2);
+        const vec<3, T> c1 = vec<3, T>::cross(a2, a0);
+        const vec<3, T> c2 = vec<3, T>::cross(a0, a1);
+
+        const T determinant = vec<3, T>::dot(a0, c0);
+
+        GLA_ASSERT(determinant != 0, "the given mat4x4 has a singular upper 3x3, therefore it does not have a normal matrix!")
+
+        const T inverse_determinant = 1 / determinant;
+
+        return { c0 * inverse_determinant, c1 * inverse_determinant, c2 * inverse_determinant };
+    }
+
+    // normal matrix - fast path for rotations with a uniform (or no) scale, where the inverse-transpose is the upper 3x3 over the squared scale
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR mat<3, 3, T> normal_matrix_uniform(const mat<4, 4, T> &model)
+    {
+        const T squared_scale = model[0][0] * model[0][0] + model[0][1] * model[0][1] + model[0][2] * model[0][2];
+
+        GLA_ASSERT(squared_scale != 0, "the given mat4x4 has a zero scale, therefore it does not have a normal matrix!")
+
+        const T inverse_squared_scale = 1 / squared_scale;
+
+        return
+        {
+            model[0][0] * inverse_squared_scale, model[0][1] * inverse_squared_scale, model[0][2] * inverse_squared_scale,
+            model[1][0] * inverse_squared_scale, model[1][1] * inverse_squared_scale, model[1][2] * inverse_squared_scale,
+            model[2][0] * inverse_squared_scale, model[2][1] * inverse_squared_scale, model[2][2] * inverse_squared_scale
+        };
+    }
+
+    // normal matrices of 'count' model matrices
+    template<typename T>
+    static void normal_matrix(const mat<4, 4, T> *models, std::size_t count, mat<3, 3, T> *output)
+    {
+        GLA_INSTRUMENT_KERNEL("normal_matrix", count);
+
+        for (std::size_t i = 0; i < count; i++)
+        {
+            output[i] = normal_matrix(models[i]);
+        }
+    }
+
+    // normal matrices of 'count' rotation and uniform-scale model matrices
+    template<typename T>
+    static void normal_matrix_uniform(const mat<4, 4, T> *models, std::size_t count, mat<3, 3, T> *output)
+    {
+        GLA_INSTRUMENT_KERNEL("normal_matrix_uniform", count);
+
+        for (std::size_t i = 0; i < count; i++)
+        {
+            output[i] = normal_matrix_uniform(models[i]);
+        }
+    }
 }
\ No newline at end of file
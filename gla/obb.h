@@ -0,0 +1,301 @@
+#pragma once
+
+#include <limits>
+
+#include "gla.h"
+#include "eigen.h"
+
+/*
+    ┌--------------------------------------------------------------------------┐
+    |                                                                          |
+    | oriented bounding boxes:                                                 |
+    |                                                                          |
+    |   center + axes * [ -extents, extents ]                                  |
+    |                                                                          |
+    | 'axes' holds the three box axes as orthonormal columns.                  |
+    |                                                                          |
+    |   fit               principal axes of the points' covariance, then the   |
+    |                     tightest box along them                              |
+    |   overlap           separating axis test over the 15 candidate axes      |
+    |   intersect_ray     slab test in the box's frame                         |
+    |   intersect_frustum plane tests against the box's projected radius,      |
+    |                     conservative: a box near a frustum corner may be     |
+    |                     reported as intersecting                             |
+    |                                                                          |
+    | frustum planes are vec4 ( normal, distance ), a point p is inside when   |
+    | dot(normal, p) + distance >= 0. frustum_planes() extracts them from a    |
+    | projection or view-projection matrix.                                    |
+    |                                                                          |
+    └--------------------------------------------------------------------------┘
+*/
+
+namespace gla
+{
+    template<typename T>
+    struct obb
+    {
+        vec<3, T> center;
+
+        // orthonormal columns
+        mat<3, 3, T> axes;
+
+        // half sizes along each axis
+        vec<3, T> extents;
+
+        // ┌----------------------------------------------------┐
+        // │    constructors                                    |
+        // └----------------------------------------------------┘
+
+        GLA_CONSTEXPR obb() : center(), axes(mat<3, 3, T>::identity()), extents() { }
+
+        GLA_CONSTEXPR obb(const vec<3, T> &center, const mat<3, 3, T> &axes, const vec<3, T> &extents) : center(center), axes(axes), extents(extents) { }
+
+        // ┌----------------------------------------------------┐
+        // │    properties                                      |
+        // └----------------------------------------------------┘
+
+        GLA_NODISCARD GLA_CONSTEXPR T volume() const
+        {
+            return 8 * extents.x * extents.y * extents.z;
+        }
+
+        GLA_NODISCARD GLA_CONSTEXPR bool contains(const vec<3, T> &point) const
+        {
+            const vec<3, T> d = point - center;
+
+            for (int i = 0; i < 3; i++)
+            {
+                if (std::abs(vec<3, T>::dot(d, axes[i])) > extents[i]) return false;
+            }
+
+            return true;
+        }
+
+        // the eight corners, bit i of the index picks the sign along axis i
+        GLA_NODISCARD GLA_CONSTEXPR vec<3, T> corner(int index) const
+        {
+            vec<3, T> result = center;
+
+            for (int i = 0; i < 3; i++) result += axes[i] * ((index & (1 << i)) ? extents[i] : - extents[i]);
+
+            return result;
+        }
+
+        // ┌----------------------------------------------------┐
+        // │    fitting                                         |
+        // └----------------------------------------------------┘
+
+        GLA_NODISCARD static obb fit(const vec<3, T> *points, std::size_t count)
+        {
+            GLA_ASSERT(count > 0, "an obb needs at least one point to be fitted to!")
+
+            vec<3, T> mean;
+
+            for (std::size_t i = 0; i < count; i++) mean += points[i];
+
+            mean = mean / static_cast<T>(count);
+
+            // only the upper triangle is read by the eigen-solver
+            mat<3, 3, T> covariance;
+
+            for (std::size_t i = 0; i < count; i++)
+            {
+                const vec<3, T> d = points[i] - mean;
+
+                for (int c = 0; c < 3; c++)
+                {
+                    for (int r = 0; r <= c; r++) covariance[c][r] += d[c] * d[r];
+                }
+            }
+
+            obb result;
+
+            result.axes = eigen_symmetric(covariance).vectors;
+
+            vec<3, T> lowest(std::numeric_limits<T>::max());
+            vec<3, T> highest(std::numeric_limits<T>::lowest());
+
+            for (std::size_t i = 0; i < count; i++)
+            {
+                for (int k = 0; k < 3; k++)
+                {
+                    const T projection = vec<3, T>::dot(points[i], result.axes[k]);
+
+                    lowest[k] = std::min(lowest[k], projection);
+                    highest[k] = std::max(highest[k], projection);
+                }
+            }
+
+            for (int k = 0; k < 3; k++)
+            {
+                result.center += result.axes[k] * ((lowest[k] + highest[k]) / 2);
+                result.extents[k] = (highest[k] - lowest[k]) / 2;
+            }
+
+            return result;
+        }
+    };
+
+    typedef obb<float>  fobb;
+    typedef obb<double> dobb;
+
+    // ┌----------------------------------------------------┐
+    // │    overlap                                         |
+    // └----------------------------------------------------┘
+
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR bool overlap(const obb<T> &a, const obb<T> &b)
+    {
+        // b's axes in a's frame, padded so that near-parallel edges do not produce a zero cross product axis
+        T rotation[3][3] = { };
+        T absolute[3][3] = { };
+
+        for (int i = 0; i < 3; i++)
+        {
+            for (int j = 0; j < 3; j++)
+            {
+                rotation[i][j] = vec<3, T>::dot(a.axes[i], b.axes[j]);
+                absolute[i][j] = std::abs(rotation[i][j]) + static_cast<T>(EPSILON);
+            }
+        }
+
+        const vec<3, T> d = b.center - a.center;
+
+        const T t[3] = { vec<3, T>::dot(d, a.axes[0]), vec<3, T>::dot(d, a.axes[1]), vec<3, T>::dot(d, a.axes[2]) };
+
+        // a's axes
+        for (int i = 0; i < 3; i++)
+        {
+            const T rb = b.extents[0] * absolute[i][0] + b.extents[1] * absolute[i][1] + b.extents[2] * absolute[i][2];
+
+            if (std::abs(t[i]) > a.extents[i] + rb) return false;
+        }
+
+        // b's axes
+        for (int j = 0; j < 3; j++)
+        {
+            const T ra = a.extents[0] * absolute[0][j] + a.extents[1] * absolute[1][j] + a.extents[2] * absolute[2][j];
+
+            if (std::abs(t[0] * rotation[0][j] + t[1] * rotation[1][j] + t[2] * rotation[2][j]) > ra + b.extents[j]) return false;
+        }
+
+        // cross(a.axes[i], b.axes[j])
+        for (int i = 0; i < 3; i++)
+        {
+            const int i1 = (i + 1) % 3;
+            const int i2 = (i + 2) % 3;
+
+            for (int j = 0; j < 3; j++)
+            {
+                const int j1 = (j + 1) % 3;
+                const int j2 = (j + 2) % 3;
+
+                const T ra = a.extents[i1] * absolute[i2][j] + a.extents[i2] * absolute[i1][j];
+                const T rb = b.extents[j1] * absolute[i][j2] + b.extents[j2] * absolute[i][j1];
+
+                if (std::abs(t[i2] * rotation[i1][j] - t[i1] * rotation[i2][j]) > ra + rb) return false;
+            }
+        }
+
+        return true;
+    }
+
+    // tests each candidate pair (pairs[2 * i], pairs[2 * i + 1]), writes the indices of the overlapping candidates
+    // to 'overlapping' in order and returns how many there are. 'overlapping' must hold 'count' entries, not just
+    // the hits: every candidate is stored and a miss is overwritten by the next one, so a trailing miss lands past the hits
+    template<typename T>
+    static std::size_t overlap(const obb<T> *boxes, const std::uint32_t *pairs, std::size_t count, std::uint32_t *overlapping)
+    {
+        GLA_INSTRUMENT_KERNEL("overlap", count);
+
+        std::size_t written = 0;
+
+        for (std::size_t i = 0; i < count; i++)
+        {
+            overlapping[written] = static_cast<std::uint32_t>(i);
+
+            // unconditional store, the count only advances on a hit
+            written += overlap(boxes[pairs[2 * i]], boxes[pairs[2 * i + 1]]) ? 1 : 0;
+        }
+
+        return written;
+    }
+
+    // ┌----------------------------------------------------┐
+    // │    rays                                            |
+    // └----------------------------------------------------┘
+
+    // 'distance' receives the entry point along the ray, zero when the origin is inside
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR bool intersect_ray(const obb<T> &box, const vec<3, T> &origin, const vec<3, T> &direction, T *distance = nullptr)
+    {
+        const vec<3, T> d = origin - box.center;
+
+        T near = 0;
+        T far = std::numeric_limits<T>::max();
+
+        for (int i = 0; i < 3; i++)
+        {
+            const T o = vec<3, T>::dot(d, box.axes[i]);
+            const T v = vec<3, T>::dot(direction, box.axes[i]);
+
+            if (v == 0)
+            {
+                // parallel to the slab
+                if (std::abs(o) > box.extents[i]) return false;
+
+                continue;
+            }
+
+            const T t0 = (- box.extents[i] - o) / v;
+            const T t1 = (  box.extents[i] - o) / v;
+
+            near = std::max(near, std::min(t0, t1));
+            far = std::min(far, std::max(t0, t1));
+
+            if (near > far) return false;
+        }
+
+        if (distance != nullptr) *distance = near;
+
+        return true;
+    }
+
+    // ┌----------------------------------------------------┐
+    // │    frustums                                        |
+    // └----------------------------------------------------┘
+
+    // left, right, bottom, top, near, far, pointing inwards and not normalized, for clip = m * p with -w <= z <= w
+    template<typename T>
+    static GLA_CONSTEXPR void frustum_planes(const mat<4, 4, T> &m, vec<4, T> (&planes)[6])
+    {
+        vec<4, T> rows[4];
+
+        for (int r = 0; r < 4; r++) rows[r] = vec<4, T>(m[0][r], m[1][r], m[2][r], m[3][r]);
+
+        planes[0] = rows[3] + rows[0];
+        planes[1] = rows[3] - rows[0];
+        planes[2] = rows[3] + rows[1];
+        planes[3] = rows[3] - rows[1];
+        planes[4] = rows[3] + rows[2];
+        planes[5] = rows[3] - rows[2];
+    }
+
+    // false when the box is fully outside one of the planes
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR bool intersect_frustum(const obb<T> &box, const vec<4, T> (&planes)[6])
+    {
+        for (const vec<4, T> &plane : planes)
+        {
+            const vec<3, T> normal(plane.x, plane.y, plane.z);
+
+            const T radius = box.extents.x * std::abs(vec<3, T>::dot(normal, box.axes[0]))
+                           + box.extents.y * std::abs(vec<3, T>::dot(normal, box.axes[1]))
+                           + box.extents.z * std::abs(vec<3, T>::dot(normal, box.axes[2]));
+
+            if (vec<3, T>::dot(normal, box.center) + plane.w < - radius) return false;
+        }
+
+        return true;
+    }
+}
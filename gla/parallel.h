@@ -0,0 +1,87 @@
+#pragma once
+
+#include "gla.h"
+
+#if GLA_USE_THREADS
+    #include <atomic>
+    #include <thread>
+    #include <vector>
+#endif
+
+/*
+    ┌--------------------------------------------------------------------------┐
+    |                                                                          |
+    | fork-join helper for the parallel kernels:                               |
+    |                                                                          |
+    |   parallel_for(begin, end, grain, body) calls body(first, last) on       |
+    |   chunks of at most 'grain' indices. workers (and the calling thread)    |
+    |   pull chunks from a shared counter until none are left, then join.      |
+    |                                                                          |
+    | threads are started per call, so it only pays off for batches that       |
+    | take well over the cost of spawning them. with GLA_USE_THREADS off,      |
+    | or a single chunk, everything runs on the calling thread.                |
+    |                                                                          |
+    └--------------------------------------------------------------------------┘
+*/
+
+namespace gla
+{
+    GLA_NODISCARD inline std::size_t hardware_threads()
+    {
+    #if GLA_USE_THREADS
+        const std::size_t count = std::thread::hardware_concurrency();
+
+        return (count != 0) ? count : 1;
+    #else
+        return 1;
+    #endif
+    }
+
+    template<typename F>
+    static void parallel_for(std::size_t begin, std::size_t end, std::size_t grain, F &&body)
+    {
+        if (begin >= end) return;
+
+        if (grain == 0) grain = 1;
+
+        const std::size_t chunks = (end - begin + grain - 1) / grain;
+
+    #if GLA_USE_THREADS
+        const std::size_t workers = std::min(chunks, hardware_threads()) - 1;
+
+        if (workers > 0)
+        {
+            std::atomic<std::size_t> next { 0 };
+
+            const auto run = [&]()
+            {
+                for (std::size_t chunk = next.fetch_add(1); chunk < chunks; chunk = next.fetch_add(1))
+                {
+                    const std::size_t first = begin + chunk * grain;
+
+                    body(first, std::min(first + grain, end));
+                }
+            };
+
+            std::vector<std::thread> threads;
+
+            threads.reserve(workers);
+
+            for (std::size_t i = 0; i < workers; i++) threads.emplace_back(run);
+
+            run();
+
+            for (std::thread &thread : threads) thread.join();
+
+            return;
+        }
+    #endif
+
+        for (std::size_t chunk = 0; chunk < chunks; chunk++)
+        {
+            const std::size_t first = begin + chunk * grain;
+
+            body(first, std::min(first + grain, end));
+        }
+    }
+}
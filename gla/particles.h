@@ -0,0 +1,292 @@
+#pragma once
+
+#include "gla.h"
+#include "simd.h"
+#include "parallel.h"
+
+/*
+    ┌--------------------------------------------------------------------------┐
+    |                                                                          |
+    | particle integrators over soa streams, one array per component:          |
+    |                                                                          |
+    |   integrate_euler()    semi-implicit euler                               |
+    |                                                                          |
+    |        v' = (v + (a + g) * dt) / (1 + damping * dt)                      |
+    |        p' = p + v' * dt                                                  |
+    |                                                                          |
+    |   integrate_verlet()   position verlet, the velocity is implied by the   |
+    |                        previous position                                 |
+    |                                                                          |
+    |        p' = p + (p - previous) / (1 + damping * dt) + (a + g) * dt^2     |
+    |        previous' = p                                                     |
+    |                                                                          |
+    | verlet keeps the velocity as a difference of positions, so in float it   |
+    | loses precision with small steps far from the origin.                    |
+    |                                                                          |
+    | damping is applied implicitly, so it is stable for any step and          |
+    | damping. 'acceleration' and the per-particle 'damping' may be null,      |
+    | then only gravity and step.damping apply.                                |
+    |                                                                          |
+    | with step.bounded set, positions are clamped into [ lowest, highest ]    |
+    | and a particle loses its velocity along every axis it was clamped on.    |
+    |                                                                          |
+    | streams are split into chunks across threads with parallel_for(), the    |
+    | sse kernels do four particles per step with fused multiply-adds when     |
+    | GLA_SIMD_FMA is set.                                                     |
+    |                                                                          |
+    └--------------------------------------------------------------------------┘
+*/
+
+namespace gla
+{
+    // x, y and z arrays of one soa stream
+    template<typename T>
+    struct stream3
+    {
+        T *x = nullptr;
+        T *y = nullptr;
+        T *z = nullptr;
+
+        stream3() = default;
+
+        stream3(T *x, T *y, T *z) : x(x), y(y), z(z)
+        {
+
+        }
+
+        GLA_NODISCARD T * operator [] (std::size_t index) const
+        {
+            GLA_ASSERT(index < 3, "stream3 index out of range!")
+
+            return (index == 0) ? x : (index == 1) ? y : z;
+        }
+    };
+
+    template<typename T>
+    struct particle_step
+    {
+        T dt = T(1) / 60;
+
+        vec<3, T> gravity = vec<3, T>(0, T(-9.81), 0);
+
+        // used when there is no per-particle damping
+        T damping = 0;
+
+        bool bounded = false;
+
+        vec<3, T> lowest;
+        vec<3, T> highest;
+    };
+
+    namespace detail
+    {
+        const std::size_t PARTICLE_GRAIN = 16384;
+
+        template<typename T>
+        static void euler_chunk(const stream3<T> &position, const stream3<T> &velocity, const stream3<const T> &acceleration, const T *damping,
+                                std::size_t first, std::size_t last, const particle_step<T> &step)
+        {
+            const T dt = step.dt;
+            const T uniform = 1 / (1 + step.damping * dt);
+
+            for (int k = 0; k < 3; k++)
+            {
+                T *p = position[k];
+                T *v = velocity[k];
+                const T *a = acceleration[k];
+
+                const T g = step.gravity[k];
+
+                for (std::size_t i = first; i < last; i++)
+                {
+                    const T factor = (damping != nullptr) ? 1 / (1 + damping[i] * dt) : uniform;
+
+                    T vi = (((a != nullptr) ? a[i] + g : g) * dt + v[i]) * factor;
+                    T pi = vi * dt + p[i];
+
+                    if (step.bounded)
+                    {
+                        const T clamped = clamp(pi, step.lowest[k], step.highest[k]);
+
+                        vi = (clamped != pi) ? T(0) : vi;
+                        pi = clamped;
+                    }
+
+                    p[i] = pi;
+                    v[i] = vi;
+                }
+            }
+        }
+
+        template<typename T>
+        static void verlet_chunk(const stream3<T> &position, const stream3<T> &previous, const stream3<const T> &acceleration, const T *damping,
+                                 std::size_t first, std::size_t last, const particle_step<T> &step)
+        {
+            const T dt = step.dt;
+            const T dt2 = dt * dt;
+            const T uniform = 1 / (1 + step.damping * dt);
+
+            for (int k = 0; k < 3; k++)
+            {
+                T *p = position[k];
+                T *q = previous[k];
+                const T *a = acceleration[k];
+
+                const T g = step.gravity[k];
+
+                for (std::size_t i = first; i < last; i++)
+                {
+                    const T factor = (damping != nullptr) ? 1 / (1 + damping[i] * dt) : uniform;
+
+                    const T current = p[i];
+
+                    T next = ((a != nullptr) ? a[i] + g : g) * dt2 + ((current - q[i]) * factor + current);
+                    T before = current;
+
+                    if (step.bounded)
+                    {
+                        const T clamped = clamp(next, step.lowest[k], step.highest[k]);
+
+                        before = (clamped != next) ? clamped : before;
+                        next = clamped;
+                    }
+
+                    p[i] = next;
+                    q[i] = before;
+                }
+            }
+        }
+
+    #if GLA_SIMD_SSE2
+
+        // four damping factors
+        inline __m128 damping_factors(const float *damping, std::size_t i, __m128 dt, __m128 uniform)
+        {
+            const __m128 one = _mm_set1_ps(1.0F);
+
+            return (damping != nullptr) ? _mm_div_ps(one, simd::madd(_mm_loadu_ps(damping + i), dt, one)) : uniform;
+        }
+
+        inline void euler_chunk(const stream3<float> &position, const stream3<float> &velocity, const stream3<const float> &acceleration, const float *damping,
+                                std::size_t first, std::size_t last, const particle_step<float> &step)
+        {
+            const std::size_t end = first + (last - first) / 4 * 4;
+
+            const __m128 dt = _mm_set1_ps(step.dt);
+            const __m128 uniform = _mm_set1_ps(1 / (1 + step.damping * step.dt));
+
+            for (int k = 0; k < 3; k++)
+            {
+                float *p = position[k];
+                float *v = velocity[k];
+                const float *a = acceleration[k];
+
+                const __m128 g = _mm_set1_ps(step.gravity[k]);
+                const __m128 lowest = _mm_set1_ps(step.lowest[k]);
+                const __m128 highest = _mm_set1_ps(step.highest[k]);
+
+                for (std::size_t i = first; i < end; i += 4)
+                {
+                    const __m128 factor = damping_factors(damping, i, dt, uniform);
+
+                    const __m128 ai = (a != nullptr) ? _mm_add_ps(_mm_loadu_ps(a + i), g) : g;
+
+                    __m128 vi = _mm_mul_ps(simd::madd(ai, dt, _mm_loadu_ps(v + i)), factor);
+                    __m128 pi = simd::madd(vi, dt, _mm_loadu_ps(p + i));
+
+                    if (step.bounded)
+                    {
+                        const __m128 clamped = _mm_min_ps(_mm_max_ps(pi, lowest), highest);
+
+                        vi = _mm_andnot_ps(_mm_cmpneq_ps(clamped, pi), vi);
+                        pi = clamped;
+                    }
+
+                    _mm_storeu_ps(p + i, pi);
+                    _mm_storeu_ps(v + i, vi);
+                }
+            }
+
+            euler_chunk<float>(position, velocity, acceleration, damping, end, last, step);
+        }
+
+        inline void verlet_chunk(const stream3<float> &position, const stream3<float> &previous, const stream3<const float> &acceleration, const float *damping,
+                                 std::size_t first, std::size_t last, const particle_step<float> &step)
+        {
+            const std::size_t end = first + (last - first) / 4 * 4;
+
+            const __m128 dt = _mm_set1_ps(step.dt);
+            const __m128 dt2 = _mm_set1_ps(step.dt * step.dt);
+            const __m128 uniform = _mm_set1_ps(1 / (1 + step.damping * step.dt));
+
+            for (int k = 0; k < 3; k++)
+            {
+                float *p = position[k];
+                float *q = previous[k];
+                const float *a = acceleration[k];
+
+                const __m128 g = _mm_set1_ps(step.gravity[k]);
+                const __m128 lowest = _mm_set1_ps(step.lowest[k]);
+                const __m128 highest = _mm_set1_ps(step.highest[k]);
+
+                for (std::size_t i = first; i < end; i += 4)
+                {
+                    const __m128 factor = damping_factors(damping, i, dt, uniform);
+
+                    const __m128 ai = (a != nullptr) ? _mm_add_ps(_mm_loadu_ps(a + i), g) : g;
+
+                    const __m128 current = _mm_loadu_ps(p + i);
+
+                    __m128 next = simd::madd(ai, dt2, simd::madd(_mm_sub_ps(current, _mm_loadu_ps(q + i)), factor, current));
+                    __m128 before = current;
+
+                    if (step.bounded)
+                    {
+                        const __m128 clamped = _mm_min_ps(_mm_max_ps(next, lowest), highest);
+                        const __m128 moved = _mm_cmpneq_ps(clamped, next);
+
+                        before = _mm_or_ps(_mm_and_ps(moved, clamped), _mm_andnot_ps(moved, before));
+                        next = clamped;
+                    }
+
+                    _mm_storeu_ps(p + i, next);
+                    _mm_storeu_ps(q + i, before);
+                }
+            }
+
+            verlet_chunk<float>(position, previous, acceleration, damping, end, last, step);
+        }
+
+    #endif
+    }
+
+    // ┌----------------------------------------------------┐
+    // │    integrators                                     |
+    // └----------------------------------------------------┘
+
+    // 'damping' does not take part in deducing T, so it can be passed as a plain nullptr
+    template<typename T>
+    static void integrate_euler(const stream3<T> &position, const stream3<T> &velocity, const stream3<const T> &acceleration, const typename std::common_type<T>::type *damping,
+                                std::size_t count, const particle_step<T> &step)
+    {
+        GLA_INSTRUMENT_KERNEL("integrate_euler", count);
+
+        parallel_for(0, count, detail::PARTICLE_GRAIN, [&](std::size_t first, std::size_t last)
+        {
+            detail::euler_chunk(position, velocity, acceleration, damping, first, last, step);
+        });
+    }
+
+    // 'previous' holds the positions of the last step and is advanced along with 'position'
+    template<typename T>
+    static void integrate_verlet(const stream3<T> &position, const stream3<T> &previous, const stream3<const T> &acceleration, const typename std::common_type<T>::type *damping,
+                                 std::size_t count, const particle_step<T> &step)
+    {
+        GLA_INSTRUMENT_KERNEL("integrate_verlet", count);
+
+        parallel_for(0, count, detail::PARTICLE_GRAIN, [&](std::size_t first, std::size_t last)
+        {
+            detail::verlet_chunk(position, previous, acceleration, damping, first, last, step);
+        });
+    }
+}
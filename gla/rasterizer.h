@@ -0,0 +1,469 @@
+#pragma once
+
+#include <vector>
+
+#include "gla.h"
+#include "simd.h"
+#include "parallel.h"
+#include "clipping.h"
+
+/*
+    ┌--------------------------------------------------------------------------┐
+    |                                                                          |
+    | tile-binned software rasterizer, a gpu-free reference renderer:          |
+    |                                                                          |
+    |   1. vertex stage      clip = mvp * position                             |
+    |   2. clipping          against the frustum, see clipping.h               |
+    |   3. setup             perspective divide, viewport, edge functions      |
+    |   4. binning           every triangle goes to the tiles its bounds touch |
+    |   5. rasterization     per tile, in parallel: 8x8 block coverage masks   |
+    |                        from the edge functions, depth test, shading      |
+    |                                                                          |
+    | clip space follows perspective() and orthographic(): -w <= z <= w.       |
+    | the framebuffer origin is the top-left pixel, depth is stored in [0, 1]  |
+    | and cleared to 1, smaller is closer. counter-clockwise is front-facing.  |
+    |                                                                          |
+    | the shader gets a fragment with perspective-correct barycentrics of the  |
+    | original (unclipped) triangle and returns a packed rgba8 color. tiles    |
+    | are shaded concurrently, so the shader must be thread-safe.              |
+    |                                                                          |
+    | pixels are covered by the top-left rule on snapped vertices, so          |
+    | triangles sharing an edge never shade the same pixel twice. snapping     |
+    | stays exact as long as framebuffers are under 8192 pixels wide.          |
+    |                                                                          |
+    └--------------------------------------------------------------------------┘
+*/
+
+namespace gla
+{
+    // packs a [0, 1] color into rgba8, red in the lowest byte
+    GLA_NODISCARD static GLA_CONSTEXPR std::uint32_t pack_rgba8(const vec4 &color)
+    {
+        return  static_cast<std::uint32_t>(clamp(color.x, 0.0F, 1.0F) * 255 + 0.5F)
+             | (static_cast<std::uint32_t>(clamp(color.y, 0.0F, 1.0F) * 255 + 0.5F) << 8)
+             | (static_cast<std::uint32_t>(clamp(color.z, 0.0F, 1.0F) * 255 + 0.5F) << 16)
+             | (static_cast<std::uint32_t>(clamp(color.w, 0.0F, 1.0F) * 255 + 0.5F) << 24);
+    }
+
+    struct fragment
+    {
+        int x, y;
+
+        float depth;
+
+        // perspective-correct weights of the triangle's three vertices
+        vec3 barycentric;
+
+        std::uint32_t triangle;
+    };
+
+    struct rasterizer
+    {
+        enum class culling
+        {
+            none,
+            back,
+            front
+        };
+
+        static GLA_CONSTEXPR const int BLOCK = 8;
+
+        culling cull = culling::back;
+
+    private:
+        // a triangle ready for rasterization, in pixel space
+        struct setup_triangle
+        {
+            // edge functions a * (x - x0) + b * (y - y0), positive inside. vertices are snapped to 1/256 of a pixel,
+            // which keeps every evaluation exact in double, so neighbours agree on the sign along a shared edge
+            double a[3], b[3], x0[3], y0[3];
+
+            // pixels exactly on the edge belong to top-left edges only
+            bool top_left[3];
+
+            double inverse_area;
+
+            float z[3];
+            float inverse_w[3];
+
+            // barycentrics of each vertex within the original triangle
+            vec3 origin[3];
+
+            int min_x, min_y, max_x, max_y;
+
+            std::uint32_t triangle;
+        };
+
+        int width_;
+        int height_;
+        int tile_size;
+        int tiles_x;
+        int tiles_y;
+
+        std::vector<std::uint32_t> color_buffer;
+        std::vector<float> depth_buffer;
+
+        std::vector<vec4> clip;
+        std::vector<std::uint32_t> codes;
+        std::vector<clipped_triangle> clipped;
+        std::vector<setup_triangle> triangles;
+        std::vector<std::vector<std::uint32_t>> bins;
+
+    public:
+        // ┌----------------------------------------------------┐
+        // │    constructors                                    |
+        // └----------------------------------------------------┘
+
+        rasterizer(int width, int height, int tile_size = 64)
+            : width_(width), height_(height), tile_size(tile_size),
+              tiles_x((width + tile_size - 1) / tile_size), tiles_y((height + tile_size - 1) / tile_size),
+              color_buffer(static_cast<std::size_t>(width) * height, 0), depth_buffer(static_cast<std::size_t>(width) * height, 1.0F),
+              clipped(1024 * CLIP_MAX_TRIANGLES), bins(static_cast<std::size_t>(tiles_x) * tiles_y)
+        {
+            GLA_ASSERT(width > 0 && height > 0, "the rasterizer needs a non-empty framebuffer!")
+            GLA_ASSERT(tile_size > 0 && tile_size % BLOCK == 0, "the rasterizer tile size must be a multiple of the block size!")
+        }
+
+        // ┌----------------------------------------------------┐
+        // │    properties                                      |
+        // └----------------------------------------------------┘
+
+        GLA_NODISCARD int width() const { return width_; }
+        GLA_NODISCARD int height() const { return height_; }
+
+        // row-major, top row first
+        GLA_NODISCARD const std::uint32_t * color() const { return color_buffer.data(); }
+        GLA_NODISCARD const float * depth() const { return depth_buffer.data(); }
+
+        void clear(std::uint32_t color, float depth = 1.0F)
+        {
+            std::fill(color_buffer.begin(), color_buffer.end(), color);
+            std::fill(depth_buffer.begin(), depth_buffer.end(), depth);
+        }
+
+        // draws 'triangle_count' indexed triangles, calling 'shader(const fragment &)' for every visible pixel
+        template<typename S>
+        void draw(const mat4x4 &mvp, const vec3 *positions, std::size_t vertex_count, const std::uint32_t *indices, std::size_t triangle_count, S &&shader)
+        {
+            GLA_INSTRUMENT_KERNEL("rasterizer::draw", triangle_count);
+
+            transform(mvp, positions, vertex_count);
+
+            assemble(indices, triangle_count);
+
+            bin();
+
+            parallel_for(0, bins.size(), 1, [&](std::size_t first, std::size_t last)
+            {
+                for (std::size_t tile = first; tile < last; tile++)
+                {
+                    rasterize_tile(tile, shader);
+                }
+            });
+        }
+
+    private:
+        // ┌----------------------------------------------------┐
+        // │    vertex stage                                    |
+        // └----------------------------------------------------┘
+
+        void transform(const mat4x4 &mvp, const vec3 *positions, std::size_t count)
+        {
+            clip.resize(count);
+            codes.resize(count);
+
+            parallel_for(0, count, 16384, [&](std::size_t first, std::size_t last)
+            {
+                for (std::size_t i = first; i < last; i++)
+                {
+                    const vec3 &p = positions[i];
+
+                    clip[i] = mvp[0] * p.x + mvp[1] * p.y + mvp[2] * p.z + mvp[3];
+                }
+
+                outcodes(clip.data() + first, last - first, codes.data() + first);
+            });
+        }
+
+        // ┌----------------------------------------------------┐
+        // │    clipping and setup                              |
+        // └----------------------------------------------------┘
+
+        void assemble(const std::uint32_t *indices, std::size_t count)
+        {
+            triangles.clear();
+
+            // the clip output is flushed to setup whenever it fills up, so it stays small however large the mesh
+            for (std::size_t first = 0; first < count; )
+            {
+                const clip_result result = clip_triangles(clip.data(), codes.data(), indices + first * 3, count - first, clipped.data(), clipped.size());
+
+                for (std::size_t i = 0; i < result.written; i++)
+                {
+                    clipped[i].triangle += static_cast<std::uint32_t>(first);
+
+                    setup(clipped[i]);
+                }
+
+                first += result.consumed;
+            }
+        }
+
+        void setup(const clipped_triangle &triangle)
+        {
+            setup_triangle s;
+
+            double x[3], y[3];
+
+            for (int k = 0; k < 3; k++)
+            {
+                const vec4 &p = triangle.position[k];
+
+                s.inverse_w[k] = 1 / p.w;
+
+                // viewport, y flipped so that row 0 is the top, snapped to the sub-pixel grid
+                x[k] = std::round((p.x * s.inverse_w[k] + 1) * 0.5 * width_ * 256) / 256;
+                y[k] = std::round((1 - p.y * s.inverse_w[k]) * 0.5 * height_ * 256) / 256;
+
+                s.z[k] = (p.z * s.inverse_w[k] + 1) * 0.5F;
+
+                s.origin[k] = triangle.barycentric[k];
+            }
+
+            // twice the signed area, negative for counter-clockwise in ndc because of the y flip
+            double area = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+
+            if (area == 0) return;
+
+            if (cull == culling::back && area > 0) return;
+            if (cull == culling::front && area < 0) return;
+
+            // make the inside positive
+            const double orientation = (area < 0) ? -1 : 1;
+
+            area *= orientation;
+
+            for (int k = 0; k < 3; k++)
+            {
+                // edge opposite to vertex k, from vertex k + 1 to k + 2
+                const int i = (k + 1) % 3;
+                const int j = (k + 2) % 3;
+
+                s.a[k] = - (y[j] - y[i]) * orientation;
+                s.b[k] =   (x[j] - x[i]) * orientation;
+                s.x0[k] = x[i];
+                s.y0[k] = y[i];
+
+                // a neighbour sharing this edge sees it with a and b negated, so exactly one of the two owns it
+                s.top_left[k] = s.a[k] > 0 || (s.a[k] == 0 && s.b[k] < 0);
+            }
+
+            s.inverse_area = 1 / area;
+
+            s.min_x = static_cast<int>(std::max(0.0, std::floor(std::min({ x[0], x[1], x[2] }))));
+            s.min_y = static_cast<int>(std::max(0.0, std::floor(std::min({ y[0], y[1], y[2] }))));
+            s.max_x = static_cast<int>(std::min(width_ - 1.0, std::ceil(std::max({ x[0], x[1], x[2] }))));
+            s.max_y = static_cast<int>(std::min(height_ - 1.0, std::ceil(std::max({ y[0], y[1], y[2] }))));
+
+            if (s.min_x > s.max_x || s.min_y > s.max_y) return;
+
+            s.triangle = triangle.triangle;
+
+            triangles.push_back(s);
+        }
+
+        // ┌----------------------------------------------------┐
+        // │    binning                                         |
+        // └----------------------------------------------------┘
+
+        void bin()
+        {
+            for (std::vector<std::uint32_t> &tile : bins) tile.clear();
+
+            for (std::size_t t = 0; t < triangles.size(); t++)
+            {
+                const setup_triangle &s = triangles[t];
+
+                for (int ty = s.min_y / tile_size; ty <= s.max_y / tile_size; ty++)
+                {
+                    for (int tx = s.min_x / tile_size; tx <= s.max_x / tile_size; tx++)
+                    {
+                        bins[static_cast<std::size_t>(ty) * tiles_x + tx].push_back(static_cast<std::uint32_t>(t));
+                    }
+                }
+            }
+        }
+
+        // ┌----------------------------------------------------┐
+        // │    rasterization                                   |
+        // └----------------------------------------------------┘
+
+        // one bit per pixel of the 8x8 block at (x, y), row by row
+        GLA_NODISCARD static std::uint64_t coverage(const setup_triangle &s, int x, int y)
+        {
+            std::uint64_t mask = ~0ULL;
+
+            for (int k = 0; k < 3; k++)
+            {
+                const double origin = s.a[k] * (x + 0.5 - s.x0[k]) + s.b[k] * (y + 0.5 - s.y0[k]);
+
+                // the function is linear, so its extremes over the block are at the corners
+                const double step_x = s.a[k] * (BLOCK - 1);
+                const double step_y = s.b[k] * (BLOCK - 1);
+
+                const double lowest = origin + std::min(step_x, 0.0) + std::min(step_y, 0.0);
+                const double highest = origin + std::max(step_x, 0.0) + std::max(step_y, 0.0);
+
+                if (highest < 0 || (highest == 0 && !s.top_left[k])) return 0;
+
+                if (lowest > 0 || (lowest == 0 && s.top_left[k])) continue;
+
+                std::uint64_t edge = 0;
+
+            #if GLA_SIMD_SSE2
+                const __m128d a = _mm_set1_pd(s.a[k]);
+
+                // columns 0 - 1, 2 - 3, 4 - 5 and 6 - 7
+                const __m128d c01 = _mm_add_pd(_mm_set1_pd(origin), _mm_mul_pd(a, _mm_set_pd(1, 0)));
+                const __m128d c23 = _mm_add_pd(_mm_set1_pd(origin), _mm_mul_pd(a, _mm_set_pd(3, 2)));
+                const __m128d c45 = _mm_add_pd(_mm_set1_pd(origin), _mm_mul_pd(a, _mm_set_pd(5, 4)));
+                const __m128d c67 = _mm_add_pd(_mm_set1_pd(origin), _mm_mul_pd(a, _mm_set_pd(7, 6)));
+
+                const __m128d zero = _mm_setzero_pd();
+
+                for (int row = 0; row < BLOCK; row++)
+                {
+                    const __m128d offset = _mm_set1_pd(s.b[k] * row);
+
+                    const __m128d e01 = _mm_add_pd(c01, offset);
+                    const __m128d e23 = _mm_add_pd(c23, offset);
+                    const __m128d e45 = _mm_add_pd(c45, offset);
+                    const __m128d e67 = _mm_add_pd(c67, offset);
+
+                    int bits;
+
+                    if (s.top_left[k])
+                    {
+                        bits =  _mm_movemask_pd(_mm_cmpge_pd(e01, zero))       | (_mm_movemask_pd(_mm_cmpge_pd(e23, zero)) << 2)
+                             | (_mm_movemask_pd(_mm_cmpge_pd(e45, zero)) << 4) | (_mm_movemask_pd(_mm_cmpge_pd(e67, zero)) << 6);
+                    }
+                    else
+                    {
+                        bits =  _mm_movemask_pd(_mm_cmpgt_pd(e01, zero))       | (_mm_movemask_pd(_mm_cmpgt_pd(e23, zero)) << 2)
+                             | (_mm_movemask_pd(_mm_cmpgt_pd(e45, zero)) << 4) | (_mm_movemask_pd(_mm_cmpgt_pd(e67, zero)) << 6);
+                    }
+
+                    edge |= static_cast<std::uint64_t>(bits) << (row * BLOCK);
+                }
+            #else
+                for (int row = 0; row < BLOCK; row++)
+                {
+                    for (int column = 0; column < BLOCK; column++)
+                    {
+                        const double e = origin + s.a[k] * column + s.b[k] * row;
+
+                        if (e > 0 || (e == 0 && s.top_left[k])) edge |= 1ULL << (row * BLOCK + column);
+                    }
+                }
+            #endif
+
+                mask &= edge;
+            }
+
+            return mask;
+        }
+
+        template<typename S>
+        void rasterize_tile(std::size_t tile, S &shader)
+        {
+            const std::vector<std::uint32_t> &bin = bins[tile];
+
+            if (bin.empty()) return;
+
+            const int tile_x = static_cast<int>(tile % tiles_x) * tile_size;
+            const int tile_y = static_cast<int>(tile / tiles_x) * tile_size;
+
+            for (std::uint32_t index : bin)
+            {
+                const setup_triangle &s = triangles[index];
+
+                // the triangle's bounds within this tile, snapped to blocks
+                const int x0 = std::max(s.min_x, tile_x) & ~(BLOCK - 1);
+                const int y0 = std::max(s.min_y, tile_y) & ~(BLOCK - 1);
+                const int x1 = std::min(s.max_x, std::min(tile_x + tile_size, width_) - 1);
+                const int y1 = std::min(s.max_y, std::min(tile_y + tile_size, height_) - 1);
+
+                for (int by = y0; by <= y1; by += BLOCK)
+                {
+                    for (int bx = x0; bx <= x1; bx += BLOCK)
+                    {
+                        std::uint64_t mask = coverage(s, bx, by);
+
+                        while (mask != 0)
+                        {
+                            const int bit = lowest_bit(mask);
+
+                            mask &= mask - 1;
+
+                            const int x = bx + (bit % BLOCK);
+                            const int y = by + (bit / BLOCK);
+
+                            if (x >= width_ || y >= height_) continue;
+
+                            shade(s, x, y, shader);
+                        }
+                    }
+                }
+            }
+        }
+
+        template<typename S>
+        void shade(const setup_triangle &s, int x, int y, S &shader)
+        {
+            const double px = x + 0.5;
+            const double py = y + 0.5;
+
+            // screen-space barycentrics
+            const float l0 = static_cast<float>((s.a[0] * (px - s.x0[0]) + s.b[0] * (py - s.y0[0])) * s.inverse_area);
+            const float l1 = static_cast<float>((s.a[1] * (px - s.x0[1]) + s.b[1] * (py - s.y0[1])) * s.inverse_area);
+            const float l2 = 1 - l0 - l1;
+
+            const float depth = l0 * s.z[0] + l1 * s.z[1] + l2 * s.z[2];
+
+            const std::size_t pixel = static_cast<std::size_t>(y) * width_ + x;
+
+            if (depth < 0 || depth >= depth_buffer[pixel]) return;
+
+            // perspective correction, then back to the original triangle
+            const float w0 = l0 * s.inverse_w[0];
+            const float w1 = l1 * s.inverse_w[1];
+            const float w2 = l2 * s.inverse_w[2];
+
+            const float inverse_sum = 1 / (w0 + w1 + w2);
+
+            fragment f;
+
+            f.x = x;
+            f.y = y;
+            f.depth = depth;
+            f.barycentric = (s.origin[0] * w0 + s.origin[1] * w1 + s.origin[2] * w2) * inverse_sum;
+            f.triangle = s.triangle;
+
+            depth_buffer[pixel] = depth;
+            color_buffer[pixel] = shader(static_cast<const fragment &>(f));
+        }
+
+        GLA_NODISCARD static int lowest_bit(std::uint64_t mask)
+        {
+        #if defined(__GNUC__) || defined(__clang__)
+            return __builtin_ctzll(mask);
+        #else
+            int bit = 0;
+
+            while ((mask & 1) == 0) { mask >>= 1; bit++; }
+
+            return bit;
+        #endif
+        }
+    };
+}
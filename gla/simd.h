@@ -0,0 +1,92 @@
+#pragma once
+
+#include "gla.h"
+
+/*
+    ┌--------------------------------------------------------------------------┐
+    |                                                                          |
+    | thin wrappers over the intrinsics used by the batched kernels.           |
+    |                                                                          |
+    | everything in here only exists when GLA_SIMD_SSE2 is set, kernels keep   |
+    | a scalar path for the other builds.                                      |
+    |                                                                          |
+    └--------------------------------------------------------------------------┘
+*/
+
+#if GLA_SIMD_SSE2
+    #include <emmintrin.h>
+#endif
+
+#if GLA_SIMD_FMA
+    #include <immintrin.h>
+#endif
+
+namespace gla
+{
+    namespace simd
+    {
+    #if GLA_SIMD_SSE2
+
+        GLA_STATIC_ASSERT(sizeof(vec4) == 4 * sizeof(float), "vec4 must be tightly packed to be loaded as a single register!");
+        GLA_STATIC_ASSERT(sizeof(mat4x4) == 16 * sizeof(float), "mat4x4 must be tightly packed to be loaded as four registers!");
+
+        inline __m128 load(const vec4 &v)
+        {
+            return _mm_loadu_ps(&v.x);
+        }
+
+        inline void store(vec4 &v, __m128 x)
+        {
+            _mm_storeu_ps(&v.x, x);
+        }
+
+        // writes the first three lanes only
+        inline void store(vec3 &v, __m128 x)
+        {
+            _mm_storel_pi(reinterpret_cast<__m64 *>(&v.x), x);
+            _mm_store_ss(&v.z, _mm_movehl_ps(x, x));
+        }
+
+        inline __m128 load(const vec3 &v)
+        {
+            return _mm_movelh_ps(_mm_loadl_pi(_mm_setzero_ps(), reinterpret_cast<const __m64 *>(&v.x)), _mm_load_ss(&v.z));
+        }
+
+        // a * b + c
+        inline __m128 madd(__m128 a, __m128 b, __m128 c)
+        {
+        #if GLA_SIMD_FMA
+            return _mm_fmadd_ps(a, b, c);
+        #else
+            return _mm_add_ps(_mm_mul_ps(a, b), c);
+        #endif
+        }
+
+        template<int lane>
+        inline __m128 splat(__m128 x)
+        {
+            return _mm_shuffle_ps(x, x, _MM_SHUFFLE(lane, lane, lane, lane));
+        }
+
+        // cross product of the first three lanes, the fourth lane comes out as zero
+        inline __m128 cross(__m128 a, __m128 b)
+        {
+            const __m128 a_yzx = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 0, 2, 1));
+            const __m128 b_yzx = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 0, 2, 1));
+
+            const __m128 c = _mm_sub_ps(_mm_mul_ps(a, b_yzx), _mm_mul_ps(a_yzx, b));
+
+            return _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 0, 2, 1));
+        }
+
+        // the sum of all four lanes, broadcast
+        inline __m128 sum(__m128 x)
+        {
+            x = _mm_add_ps(x, _mm_shuffle_ps(x, x, _MM_SHUFFLE(2, 3, 0, 1)));
+
+            return _mm_add_ps(x, _mm_shuffle_ps(x, x, _MM_SHUFFLE(1, 0, 3, 2)));
+        }
+
+    #endif
+    }
+}
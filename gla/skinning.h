@@ -0,0 +1,193 @@
+#pragma once
+
+#include "gla.h"
+#include "simd.h"
+
+/*
+    ┌--------------------------------------------------------------------------┐
+    |                                                                          |
+    | linear blend skinning:                                                   |
+    |                                                                          |
+    |        palette[j] = joint_world[j] * inverse_bind[j]                     |
+    |                                                                          |
+    |        skinned    = sum(weight[i] * palette[joint[i]]) * vertex          |
+    |                                                                          |
+    | all matrices are treated as affine, their bottom row is never read and   |
+    | is always written as [ 0 0 0 1 ]. the four weights of a vertex are       |
+    | expected to sum up to one, and unused joint slots must still index a     |
+    | valid palette entry (with a zero weight).                                |
+    |                                                                          |
+    | the blended matrix of a vertex is built and applied in registers, so     |
+    | nothing but the output streams is written. vertices are independent,     |
+    | callers may split the streams into chunks across threads.                |
+    |                                                                          |
+    └--------------------------------------------------------------------------┘
+*/
+
+namespace gla
+{
+    // ┌----------------------------------------------------┐
+    // │    scalar kernels                                  |
+    // └----------------------------------------------------┘
+
+    template<typename T>
+    static void skinning_palette(const mat<4, 4, T> *joint_world, const mat<4, 4, T> *inverse_bind, std::size_t count, mat<4, 4, T> *palette)
+    {
+        GLA_INSTRUMENT_KERNEL("skinning_palette", count);
+
+        for (std::size_t j = 0; j < count; j++)
+        {
+            palette[j] = affine_multiply(joint_world[j], inverse_bind[j]);
+        }
+    }
+
+    // 'normals' and 'output_normals' may be null
+    template<typename T>
+    static void skin_linear(const mat<4, 4, T> *palette,
+                            const vec<3, T> *positions, const vec<3, T> *normals, const uivec4 *joints, const vec<4, T> *weights, std::size_t count,
+                            vec<3, T> *output_positions, vec<3, T> *output_normals)
+    {
+        GLA_INSTRUMENT_KERNEL("skin_linear", count);
+
+        const bool skin_normals = normals != nullptr && output_normals != nullptr;
+
+        for (std::size_t i = 0; i < count; i++)
+        {
+            // blended upper 3x4, column by column
+            vec<3, T> blended[4];
+
+            for (int k = 0; k < 4; k++)
+            {
+                const T weight = weights[i][k];
+
+                if (weight == 0) continue;
+
+                const mat<4, 4, T> &joint = palette[joints[i][k]];
+
+                for (int c = 0; c < 4; c++)
+                {
+                    blended[c] += vec<3, T>(joint[c][0], joint[c][1], joint[c][2]) * weight;
+                }
+            }
+
+            const vec<3, T> &p = positions[i];
+
+            output_positions[i] = blended[0] * p.x + blended[1] * p.y + blended[2] * p.z + blended[3];
+
+            if (skin_normals)
+            {
+                const vec<3, T> &n = normals[i];
+
+                output_normals[i] = (blended[0] * n.x + blended[1] * n.y + blended[2] * n.z).normalized();
+            }
+        }
+    }
+
+    // ┌----------------------------------------------------┐
+    // │    sse kernels                                     |
+    // └----------------------------------------------------┘
+
+#if GLA_SIMD_SSE2
+
+    inline void skinning_palette(const mat4x4 *joint_world, const mat4x4 *inverse_bind, std::size_t count, mat4x4 *palette)
+    {
+        GLA_INSTRUMENT_KERNEL("skinning_palette", count);
+
+        const __m128 zero_w = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+        const __m128 unit_w = _mm_set_ps(1, 0, 0, 0);
+
+        for (std::size_t j = 0; j < count; j++)
+        {
+            const __m128 a0 = simd::load(joint_world[j][0]);
+            const __m128 a1 = simd::load(joint_world[j][1]);
+            const __m128 a2 = simd::load(joint_world[j][2]);
+            const __m128 a3 = _mm_and_ps(simd::load(joint_world[j][3]), zero_w);
+
+            for (int c = 0; c < 4; c++)
+            {
+                const __m128 b = simd::load(inverse_bind[j][c]);
+
+                __m128 column = _mm_mul_ps(a0, simd::splat<0>(b));
+
+                column = simd::madd(a1, simd::splat<1>(b), column);
+                column = simd::madd(a2, simd::splat<2>(b), column);
+
+                // keeps the bottom row at [ 0 0 0 1 ]
+                column = _mm_and_ps(column, zero_w);
+
+                simd::store(palette[j][c], (c == 3) ? _mm_add_ps(column, _mm_or_ps(a3, unit_w)) : column);
+            }
+        }
+    }
+
+    inline void skin_linear(const mat4x4 *palette,
+                            const vec3 *positions, const vec3 *normals, const uivec4 *joints, const vec4 *weights, std::size_t count,
+                            vec3 *output_positions, vec3 *output_normals)
+    {
+        GLA_INSTRUMENT_KERNEL("skin_linear", count);
+
+        const bool skin_normals = normals != nullptr && output_normals != nullptr;
+
+        const __m128 zero = _mm_setzero_ps();
+        const __m128 zero_w = _mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1));
+
+        for (std::size_t i = 0; i < count; i++)
+        {
+            const __m128 w = simd::load(weights[i]);
+
+            const mat4x4 &j0 = palette[joints[i].x];
+            const mat4x4 &j1 = palette[joints[i].y];
+            const mat4x4 &j2 = palette[joints[i].z];
+            const mat4x4 &j3 = palette[joints[i].w];
+
+            const __m128 w0 = simd::splat<0>(w);
+            const __m128 w1 = simd::splat<1>(w);
+            const __m128 w2 = simd::splat<2>(w);
+            const __m128 w3 = simd::splat<3>(w);
+
+            __m128 blended[4];
+
+            for (int c = 0; c < 4; c++)
+            {
+                __m128 column = _mm_mul_ps(simd::load(j0[c]), w0);
+
+                column = simd::madd(simd::load(j1[c]), w1, column);
+                column = simd::madd(simd::load(j2[c]), w2, column);
+                column = simd::madd(simd::load(j3[c]), w3, column);
+
+                blended[c] = column;
+            }
+
+            const vec3 &p = positions[i];
+
+            __m128 position = simd::madd(blended[0], _mm_set1_ps(p.x), blended[3]);
+
+            position = simd::madd(blended[1], _mm_set1_ps(p.y), position);
+            position = simd::madd(blended[2], _mm_set1_ps(p.z), position);
+
+            simd::store(output_positions[i], position);
+
+            if (skin_normals)
+            {
+                const vec3 &n = normals[i];
+
+                __m128 normal = _mm_mul_ps(blended[0], _mm_set1_ps(n.x));
+
+                normal = simd::madd(blended[1], _mm_set1_ps(n.y), normal);
+                normal = simd::madd(blended[2], _mm_set1_ps(n.z), normal);
+
+                // the bottom row is never read, so its lane is cleared before summing up the squared length
+                normal = _mm_and_ps(normal, zero_w);
+
+                const __m128 squared_length = simd::sum(_mm_mul_ps(normal, normal));
+                const __m128 non_zero = _mm_cmpneq_ps(squared_length, zero);
+
+                normal = _mm_and_ps(_mm_div_ps(normal, _mm_sqrt_ps(squared_length)), non_zero);
+
+                simd::store(output_normals[i], normal);
+            }
+        }
+    }
+
+#endif
+}
@@ -0,0 +1,333 @@
+#pragma once
+
+#include <vector>
+
+#include "gla.h"
+#include "parallel.h"
+#include "spatial_hash.h"
+
+#if GLA_SIMD_BMI2
+    #include <immintrin.h>
+#endif
+
+/*
+    ┌--------------------------------------------------------------------------┐
+    |                                                                          |
+    | space-filling curve keys and a radix sort to order data along them:      |
+    |                                                                          |
+    |   quantize_to_grid()  p in [ lowest, highest ] to unsigned cells of      |
+    |                       'bits' bits per axis, clamped                      |
+    |   morton_key()        interleaved bits, x lowest                         |
+    |   hilbert_key()       skilling's transform, then interleaved bits.       |
+    |                       neighbouring keys are always neighbouring cells,   |
+    |                       at the cost of a loop over the bits                |
+    |                                                                          |
+    | keys fit in 64 bits: up to 32 bits per axis in 2d, 21 bits in 3d.        |
+    | with BMI2 the bit interleaving is a single pdep per axis.                |
+    |                                                                          |
+    | radix_sort() sorts keys with a stable lsd radix sort, 8 bits a pass,     |
+    | and returns the permutation it applied. passes where all keys share      |
+    | the digit are skipped, so keys of few bits only pay for those bits.      |
+    | every pass histograms and scatters chunks in parallel, no atomics.       |
+    | reorder() then applies the permutation to each soa stream:               |
+    |                                                                          |
+    |   morton_keys(points, count, lowest, highest, keys);                     |
+    |   radix_sort(keys, count, permutation);                                  |
+    |   reorder(positions, count, permutation, sorted_positions);              |
+    |                                                                          |
+    └--------------------------------------------------------------------------┘
+*/
+
+namespace gla
+{
+    // ┌----------------------------------------------------┐
+    // │    quantization                                    |
+    // └----------------------------------------------------┘
+
+    namespace detail
+    {
+        template<typename T>
+        GLA_NODISCARD static GLA_CONSTEXPR unsigned int to_grid(T value, T lowest, T highest, unsigned int bits)
+        {
+            const std::uint64_t cells = (std::uint64_t(1) << bits) - 1;
+
+            // in double, so that 32 bit grids keep every cell
+            const double t = (highest > lowest) ? (static_cast<double>(value) - lowest) / (static_cast<double>(highest) - lowest) : 0.0;
+
+            return static_cast<unsigned int>(std::min(static_cast<std::uint64_t>(clamp(t, 0.0, 1.0) * static_cast<double>(cells) + 0.5), cells));
+        }
+    }
+
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR uivec2 quantize_to_grid(const vec<2, T> &p, const vec<2, T> &lowest, const vec<2, T> &highest, unsigned int bits = 32)
+    {
+        GLA_ASSERT(bits >= 1 && bits <= 32, "a 2d grid holds between 1 and 32 bits per axis!")
+
+        return { detail::to_grid(p.x, lowest.x, highest.x, bits), detail::to_grid(p.y, lowest.y, highest.y, bits) };
+    }
+
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR uivec3 quantize_to_grid(const vec<3, T> &p, const vec<3, T> &lowest, const vec<3, T> &highest, unsigned int bits = 21)
+    {
+        GLA_ASSERT(bits >= 1 && bits <= 21, "a 3d grid holds between 1 and 21 bits per axis!")
+
+        return { detail::to_grid(p.x, lowest.x, highest.x, bits), detail::to_grid(p.y, lowest.y, highest.y, bits), detail::to_grid(p.z, lowest.z, highest.z, bits) };
+    }
+
+    // ┌----------------------------------------------------┐
+    // │    morton                                          |
+    // └----------------------------------------------------┘
+
+    // spreads the low 32 bits of 'x' two bits apart
+    GLA_NODISCARD static GLA_CONSTEXPR std::uint64_t spread_bits_2(std::uint64_t x)
+    {
+        x &= 0xFFFFFFFFULL;
+
+        x = (x | (x << 16)) & 0x0000FFFF0000FFFFULL;
+        x = (x | (x <<  8)) & 0x00FF00FF00FF00FFULL;
+        x = (x | (x <<  4)) & 0x0F0F0F0F0F0F0F0FULL;
+        x = (x | (x <<  2)) & 0x3333333333333333ULL;
+        x = (x | (x <<  1)) & 0x5555555555555555ULL;
+
+        return x;
+    }
+
+#if GLA_SIMD_BMI2
+
+    GLA_NODISCARD inline std::uint64_t morton_key(const uivec2 &cell)
+    {
+        return _pdep_u64(cell.x, 0x5555555555555555ULL) | _pdep_u64(cell.y, 0xAAAAAAAAAAAAAAAAULL);
+    }
+
+    GLA_NODISCARD inline std::uint64_t morton_key(const uivec3 &cell)
+    {
+        return _pdep_u64(cell.x, 0x1249249249249249ULL) | _pdep_u64(cell.y, 0x2492492492492492ULL) | _pdep_u64(cell.z, 0x4924924924924924ULL);
+    }
+
+#else
+
+    GLA_NODISCARD static GLA_CONSTEXPR std::uint64_t morton_key(const uivec2 &cell)
+    {
+        return spread_bits_2(cell.x) | (spread_bits_2(cell.y) << 1);
+    }
+
+    GLA_NODISCARD static GLA_CONSTEXPR std::uint64_t morton_key(const uivec3 &cell)
+    {
+        return spread_bits_3(cell.x) | (spread_bits_3(cell.y) << 1) | (spread_bits_3(cell.z) << 2);
+    }
+
+#endif
+
+    // ┌----------------------------------------------------┐
+    // │    hilbert                                         |
+    // └----------------------------------------------------┘
+
+    namespace detail
+    {
+        // skilling, "programming the hilbert curve": turns the axes into the transposed hilbert index in place
+        template<std::size_t N>
+        static GLA_CONSTEXPR void axes_to_transpose(unsigned int (&x)[N], unsigned int bits)
+        {
+            const unsigned int highest = 1U << (bits - 1);
+
+            // inverse undo
+            for (unsigned int q = highest; q > 1; q >>= 1)
+            {
+                const unsigned int p = q - 1;
+
+                for (std::size_t i = 0; i < N; i++)
+                {
+                    if (x[i] & q)
+                    {
+                        x[0] ^= p;
+                    }
+                    else
+                    {
+                        const unsigned int t = (x[0] ^ x[i]) & p;
+
+                        x[0] ^= t;
+                        x[i] ^= t;
+                    }
+                }
+            }
+
+            // gray encode
+            for (std::size_t i = 1; i < N; i++) x[i] ^= x[i - 1];
+
+            unsigned int t = 0;
+
+            for (unsigned int q = highest; q > 1; q >>= 1)
+            {
+                if (x[N - 1] & q) t ^= q - 1;
+            }
+
+            for (std::size_t i = 0; i < N; i++) x[i] ^= t;
+        }
+    }
+
+    // 'bits' is the grid resolution the cell was quantized with
+    GLA_NODISCARD inline std::uint64_t hilbert_key(const uivec2 &cell, unsigned int bits = 32)
+    {
+        GLA_ASSERT(bits >= 1 && bits <= 32, "a 2d grid holds between 1 and 32 bits per axis!")
+
+        unsigned int x[2] = { cell.x, cell.y };
+
+        detail::axes_to_transpose(x, bits);
+
+        // the first axis holds the most significant bit of every level
+        return morton_key(uivec2(x[1], x[0]));
+    }
+
+    GLA_NODISCARD inline std::uint64_t hilbert_key(const uivec3 &cell, unsigned int bits = 21)
+    {
+        GLA_ASSERT(bits >= 1 && bits <= 21, "a 3d grid holds between 1 and 21 bits per axis!")
+
+        unsigned int x[3] = { cell.x, cell.y, cell.z };
+
+        detail::axes_to_transpose(x, bits);
+
+        return morton_key(uivec3(x[2], x[1], x[0]));
+    }
+
+    // ┌----------------------------------------------------┐
+    // │    batched keys                                    |
+    // └----------------------------------------------------┘
+
+    namespace detail
+    {
+        const std::size_t SPACE_FILLING_GRAIN = 65536;
+    }
+
+    template<std::size_t D, typename T>
+    static void morton_keys(const vec<D, T> *points, std::size_t count, const vec<D, T> &lowest, const vec<D, T> &highest, std::uint64_t *keys)
+    {
+        GLA_INSTRUMENT_KERNEL("morton_keys", count);
+
+        parallel_for(0, count, detail::SPACE_FILLING_GRAIN, [&](std::size_t first, std::size_t last)
+        {
+            for (std::size_t i = first; i < last; i++) keys[i] = morton_key(quantize_to_grid(points[i], lowest, highest));
+        });
+    }
+
+    template<std::size_t D, typename T>
+    static void hilbert_keys(const vec<D, T> *points, std::size_t count, const vec<D, T> &lowest, const vec<D, T> &highest, std::uint64_t *keys)
+    {
+        GLA_INSTRUMENT_KERNEL("hilbert_keys", count);
+
+        parallel_for(0, count, detail::SPACE_FILLING_GRAIN, [&](std::size_t first, std::size_t last)
+        {
+            for (std::size_t i = first; i < last; i++) keys[i] = hilbert_key(quantize_to_grid(points[i], lowest, highest));
+        });
+    }
+
+    // ┌----------------------------------------------------┐
+    // │    sorting                                         |
+    // └----------------------------------------------------┘
+
+    // sorts 'keys' in place, permutation[i] receives the original index of what is now at i
+    inline void radix_sort(std::uint64_t *keys, std::size_t count, std::uint32_t *permutation)
+    {
+        GLA_ASSERT(count <= 0xFFFFFFFFULL, "radix_sort() indexes with 32 bits!")
+
+        GLA_INSTRUMENT_KERNEL("radix_sort", count);
+
+        const std::size_t grain = detail::SPACE_FILLING_GRAIN;
+        const std::size_t chunks = (count + grain - 1) / grain;
+
+        std::vector<std::uint64_t> key_buffer(count);
+        std::vector<std::uint32_t> index_buffer(count);
+
+        // offsets[chunk * 256 + digit]
+        std::vector<std::size_t> offsets(chunks * 256);
+
+        for (std::size_t i = 0; i < count; i++) permutation[i] = static_cast<std::uint32_t>(i);
+
+        std::uint64_t *keys_from = keys, *keys_to = key_buffer.data();
+        std::uint32_t *indices_from = permutation, *indices_to = index_buffer.data();
+
+        for (unsigned int shift = 0; shift < 64; shift += 8)
+        {
+            std::fill(offsets.begin(), offsets.end(), std::size_t(0));
+
+            parallel_for(0, chunks, 1, [&](std::size_t first, std::size_t last)
+            {
+                for (std::size_t chunk = first; chunk < last; chunk++)
+                {
+                    std::size_t *histogram = offsets.data() + chunk * 256;
+
+                    const std::size_t end = std::min(count, (chunk + 1) * grain);
+
+                    for (std::size_t i = chunk * grain; i < end; i++) histogram[(keys_from[i] >> shift) & 0xFF]++;
+                }
+            });
+
+            // every key in the same bucket, the pass would not move anything
+            bool skip = true;
+
+            for (std::size_t digit = 0; digit < 256 && skip; digit++)
+            {
+                std::size_t total = 0;
+
+                for (std::size_t chunk = 0; chunk < chunks; chunk++) total += offsets[chunk * 256 + digit];
+
+                skip = (total == 0 || total == count);
+            }
+
+            if (skip) continue;
+
+            // exclusive prefix sum, digit major and chunk minor, keeps the sort stable
+            std::size_t sum = 0;
+
+            for (std::size_t digit = 0; digit < 256; digit++)
+            {
+                for (std::size_t chunk = 0; chunk < chunks; chunk++)
+                {
+                    const std::size_t n = offsets[chunk * 256 + digit];
+
+                    offsets[chunk * 256 + digit] = sum;
+                    sum += n;
+                }
+            }
+
+            parallel_for(0, chunks, 1, [&](std::size_t first, std::size_t last)
+            {
+                for (std::size_t chunk = first; chunk < last; chunk++)
+                {
+                    std::size_t *cursor = offsets.data() + chunk * 256;
+
+                    const std::size_t end = std::min(count, (chunk + 1) * grain);
+
+                    for (std::size_t i = chunk * grain; i < end; i++)
+                    {
+                        const std::size_t to = cursor[(keys_from[i] >> shift) & 0xFF]++;
+
+                        keys_to[to] = keys_from[i];
+                        indices_to[to] = indices_from[i];
+                    }
+                }
+            });
+
+            std::swap(keys_from, keys_to);
+            std::swap(indices_from, indices_to);
+        }
+
+        // an odd number of passes left the result in the buffers
+        if (keys_from != keys)
+        {
+            std::copy(keys_from, keys_from + count, keys);
+            std::copy(indices_from, indices_from + count, permutation);
+        }
+    }
+
+    // output[i] = input[permutation[i]], 'input' and 'output' must not overlap
+    template<typename T>
+    static void reorder(const T *input, std::size_t count, const std::uint32_t *permutation, T *output)
+    {
+        GLA_INSTRUMENT_KERNEL("reorder", count);
+
+        parallel_for(0, count, detail::SPACE_FILLING_GRAIN, [&](std::size_t first, std::size_t last)
+        {
+            for (std::size_t i = first; i < last; i++) output[i] = input[permutation[i]];
+        });
+    }
+}
@@ -0,0 +1,442 @@
+#pragma once
+
+#include <vector>
+#include <functional>
+
+#include "gla.h"
+
+/*
+    ┌--------------------------------------------------------------------------┐
+    |                                                                          |
+    | integer cells and a spatial hash grid:                                   |
+    |                                                                          |
+    |   to_cell()  - floor(p / cell_size), the cell containing a point         |
+    |   quantize() - round(p / step), the nearest lattice point                |
+    |                                                                          |
+    |   hash()        - multiplicative hash of an integer vector, also         |
+    |                   exposed as std::hash<ivecN>                            |
+    |   morton_hash() - interleaves the bits of an ivec3, so neighbouring      |
+    |                   cells get neighbouring keys                            |
+    |                                                                          |
+    | the grid is an open-addressing (linear probing) table of cells indexed   |
+    | by hash(), every cell heading a linked list of the points inside.        |
+    | points are addressed by the handle returned from insert().               |
+    |                                                                          |
+    └--------------------------------------------------------------------------┘
+*/
+
+namespace gla
+{
+    // ┌----------------------------------------------------┐
+    // │    cells                                           |
+    // └----------------------------------------------------┘
+
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR ivec2 to_cell(const vec<2, T> &p, T cell_size)
+    {
+        return { static_cast<int>(std::floor(p.x / cell_size)), static_cast<int>(std::floor(p.y / cell_size)) };
+    }
+
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR ivec3 to_cell(const vec<3, T> &p, T cell_size)
+    {
+        return { static_cast<int>(std::floor(p.x / cell_size)), static_cast<int>(std::floor(p.y / cell_size)), static_cast<int>(std::floor(p.z / cell_size)) };
+    }
+
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR ivec2 quantize(const vec<2, T> &p, T step)
+    {
+        return { static_cast<int>(std::lround(p.x / step)), static_cast<int>(std::lround(p.y / step)) };
+    }
+
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR ivec3 quantize(const vec<3, T> &p, T step)
+    {
+        return { static_cast<int>(std::lround(p.x / step)), static_cast<int>(std::lround(p.y / step)), static_cast<int>(std::lround(p.z / step)) };
+    }
+
+    // ┌----------------------------------------------------┐
+    // │    hashing                                         |
+    // └----------------------------------------------------┘
+
+    template<std::size_t D, typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR std::size_t hash(const vec<D, T> &v)
+    {
+        GLA_STATIC_ASSERT(std::is_integral<T>::value, "function 'hash()' only accepts integral value inputs!");
+
+        const std::uint64_t primes[4] = { 73856093ULL, 19349663ULL, 83492791ULL, 49979687ULL };
+
+        std::uint64_t h = 0;
+
+        for (std::size_t i = 0; i < D; i++)
+        {
+            h ^= static_cast<std::uint64_t>(v[i]) * primes[i];
+        }
+
+        // final avalanche (murmur3), so that the low bits can index a power-of-two table
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDULL;
+        h ^= h >> 33;
+
+        return static_cast<std::size_t>(h);
+    }
+
+    // spreads the low 21 bits of 'x' three bits apart
+    GLA_NODISCARD static GLA_CONSTEXPR std::uint64_t spread_bits_3(std::uint64_t x)
+    {
+        x &= 0x1FFFFFULL;
+
+        x = (x | (x << 32)) & 0x1F00000000FFFFULL;
+        x = (x | (x << 16)) & 0x1F0000FF0000FFULL;
+        x = (x | (x <<  8)) & 0x100F00F00F00F00FULL;
+        x = (x | (x <<  4)) & 0x10C30C30C30C30C3ULL;
+        x = (x | (x <<  2)) & 0x1249249249249249ULL;
+
+        return x;
+    }
+
+    // interleaved bits of the three coordinates, each biased into 21 unsigned bits
+    GLA_NODISCARD static GLA_CONSTEXPR std::uint64_t morton_hash(const ivec3 &cell)
+    {
+        const std::uint64_t bias = 1ULL << 20;
+
+        return spread_bits_3(static_cast<std::uint64_t>(cell.x) + bias)
+            | (spread_bits_3(static_cast<std::uint64_t>(cell.y) + bias) << 1)
+            | (spread_bits_3(static_cast<std::uint64_t>(cell.z) + bias) << 2);
+    }
+
+    // ┌----------------------------------------------------┐
+    // │    spatial hash grid                               |
+    // └----------------------------------------------------┘
+
+    template<typename T>
+    struct spatial_hash_grid
+    {
+        typedef std::uint32_t handle;
+
+        static GLA_CONSTEXPR const handle NONE = 0xFFFFFFFFU;
+
+    private:
+        struct entry
+        {
+            vec<3, T> position;
+
+            handle next;
+
+            bool alive;
+        };
+
+        struct slot
+        {
+            ivec3 cell;
+
+            handle head;
+
+            std::uint32_t count;
+
+            bool used;
+        };
+
+        // find() of a cell that is not in the table
+        static GLA_CONSTEXPR const std::size_t ABSENT = ~std::size_t(0);
+
+        T cell_size;
+
+        std::vector<entry> entries;
+        std::vector<slot> slots;
+
+        handle free_list;
+
+        std::size_t alive_count;
+
+        // cells in the table, including the ones emptied by remove() until the next rehash()
+        std::size_t used_slots;
+
+    public:
+        // ┌----------------------------------------------------┐
+        // │    constructors                                    |
+        // └----------------------------------------------------┘
+
+        explicit spatial_hash_grid(T cell_size, std::size_t expected_points = 1024)
+            : cell_size(cell_size), free_list(NONE), alive_count(0), used_slots(0)
+        {
+            GLA_ASSERT(cell_size > 0, "the cell size of a spatial hash grid must be positive!")
+
+            entries.reserve(expected_points);
+
+            slots.resize(table_size(expected_points));
+        }
+
+        // ┌----------------------------------------------------┐
+        // │    properties                                      |
+        // └----------------------------------------------------┘
+
+        GLA_NODISCARD std::size_t size() const
+        {
+            return alive_count;
+        }
+
+        GLA_NODISCARD const vec<3, T> & position(handle h) const
+        {
+            GLA_ASSERT(h < entries.size() && entries[h].alive, "trying to access a removed spatial hash grid point!")
+
+            return entries[h].position;
+        }
+
+        void clear()
+        {
+            entries.clear();
+
+            std::fill(slots.begin(), slots.end(), slot { });
+
+            free_list = NONE;
+            alive_count = 0;
+            used_slots = 0;
+        }
+
+        handle insert(const vec<3, T> &position)
+        {
+            handle h;
+
+            if (free_list != NONE)
+            {
+                h = free_list;
+                free_list = entries[h].next;
+            }
+            else
+            {
+                h = static_cast<handle>(entries.size());
+                entries.push_back({ });
+            }
+
+            slot &s = find_or_add(to_cell(position, cell_size));
+
+            entries[h].position = position;
+            entries[h].next = s.head;
+            entries[h].alive = true;
+
+            s.head = h;
+            s.count++;
+
+            alive_count++;
+
+            return h;
+        }
+
+        void insert(const vec<3, T> *positions, std::size_t count, handle *output)
+        {
+            GLA_INSTRUMENT_KERNEL("spatial_hash_grid::insert", count);
+
+            entries.reserve(entries.size() + count);
+
+            for (std::size_t i = 0; i < count; i++)
+            {
+                const handle h = insert(positions[i]);
+
+                if (output != nullptr) output[i] = h;
+            }
+        }
+
+        void remove(handle h)
+        {
+            GLA_ASSERT(h < entries.size() && entries[h].alive, "trying to remove a spatial hash grid point twice!")
+
+            const std::size_t index = find(to_cell(entries[h].position, cell_size));
+
+            GLA_ASSERT(index != ABSENT, "the cell of a live spatial hash grid point must be in the table!")
+
+            slot &s = slots[index];
+
+            // unlink, the lists are as short as the cells are small
+            if (s.head == h)
+            {
+                s.head = entries[h].next;
+            }
+            else
+            {
+                handle previous = s.head;
+
+                while (entries[previous].next != h) previous = entries[previous].next;
+
+                entries[previous].next = entries[h].next;
+            }
+
+            s.count--;
+
+            entries[h].alive = false;
+            entries[h].next = free_list;
+
+            free_list = h;
+
+            alive_count--;
+        }
+
+        // moves a point, only touching the table when it changes cells
+        void move(handle h, const vec<3, T> &position)
+        {
+            GLA_ASSERT(h < entries.size() && entries[h].alive, "trying to move a removed spatial hash grid point!")
+
+            if (to_cell(position, cell_size) == to_cell(entries[h].position, cell_size))
+            {
+                entries[h].position = position;
+
+                return;
+            }
+
+            remove(h);
+
+            const handle moved = insert(position);
+
+            GLA_ASSERT(moved == h, "the free list must hand the moved handle straight back!")
+        }
+
+        // ┌----------------------------------------------------┐
+        // │    queries                                         |
+        // └----------------------------------------------------┘
+
+        // calls 'visit(handle, position)' for every point in 'c'
+        template<typename F>
+        void query_cell(const ivec3 &c, F &&visit) const
+        {
+            const std::size_t index = find(c);
+
+            if (index == ABSENT) return;
+
+            for (handle h = slots[index].head; h != NONE; h = entries[h].next)
+            {
+                visit(h, entries[h].position);
+            }
+        }
+
+        // calls 'visit(handle, position)' for every point in the 27 cells around 'position'
+        template<typename F>
+        void query_neighbors(const vec<3, T> &position, F &&visit) const
+        {
+            const ivec3 center = to_cell(position, cell_size);
+
+            for (int z = -1; z <= 1; z++)
+            {
+                for (int y = -1; y <= 1; y++)
+                {
+                    for (int x = -1; x <= 1; x++)
+                    {
+                        query_cell(center + ivec3(x, y, z), visit);
+                    }
+                }
+            }
+        }
+
+        // calls 'visit(handle, position)' for every point within 'radius' of 'center'
+        template<typename F>
+        void query_radius(const vec<3, T> &center, T radius, F &&visit) const
+        {
+            const ivec3 low = to_cell(center - vec<3, T>(radius), cell_size);
+            const ivec3 high = to_cell(center + vec<3, T>(radius), cell_size);
+
+            const T squared_radius = radius * radius;
+
+            for (int z = low.z; z <= high.z; z++)
+            {
+                for (int y = low.y; y <= high.y; y++)
+                {
+                    for (int x = low.x; x <= high.x; x++)
+                    {
+                        query_cell(ivec3(x, y, z), [&](handle h, const vec<3, T> &p)
+                        {
+                            if ((p - center).squared_length() <= squared_radius) visit(h, p);
+                        });
+                    }
+                }
+            }
+        }
+
+    private:
+        GLA_NODISCARD static std::size_t table_size(std::size_t cells)
+        {
+            std::size_t size = 16;
+
+            while (size < cells * 2) size <<= 1;
+
+            return size;
+        }
+
+        // the slot of 'c', ABSENT when the cell is not in the table
+        GLA_NODISCARD std::size_t find(const ivec3 &c) const
+        {
+            const std::size_t mask = slots.size() - 1;
+
+            for (std::size_t i = hash(c) & mask; ; i = (i + 1) & mask)
+            {
+                if (!slots[i].used) return ABSENT;
+
+                if (slots[i].cell == c) return i;
+            }
+        }
+
+        slot & find_or_add(const ivec3 &c)
+        {
+            // keeps the load factor at or below one half, so probe chains stay short
+            if ((used_slots + 1) * 2 > slots.size()) rehash();
+
+            const std::size_t mask = slots.size() - 1;
+
+            std::size_t i = hash(c) & mask;
+
+            for ( ; slots[i].used; i = (i + 1) & mask)
+            {
+                if (slots[i].cell == c) return slots[i];
+            }
+
+            slots[i].cell = c;
+            slots[i].head = NONE;
+            slots[i].count = 0;
+            slots[i].used = true;
+
+            used_slots++;
+
+            return slots[i];
+        }
+
+        // drops the cells that have been emptied by remove() and only grows the table when the live cells need it
+        void rehash()
+        {
+            std::size_t live = 0;
+
+            for (const slot &s : slots) live += (s.used && s.count > 0) ? 1 : 0;
+
+            // sized for twice the live cells, so at least a quarter of the table is free for new cells before the next rehash
+            std::vector<slot> previous(std::max(slots.size(), table_size(2 * (live + 1))));
+
+            previous.swap(slots);
+
+            const std::size_t mask = slots.size() - 1;
+
+            used_slots = 0;
+
+            for (const slot &s : previous)
+            {
+                if (!s.used || s.count == 0) continue;
+
+                std::size_t i = hash(s.cell) & mask;
+
+                while (slots[i].used) i = (i + 1) & mask;
+
+                slots[i] = s;
+
+                used_slots++;
+            }
+        }
+    };
+}
+
+namespace std
+{
+    template<std::size_t D, typename T>
+    struct hash<gla::vec<D, T>>
+    {
+        std::size_t operator () (const gla::vec<D, T> &v) const
+        {
+            return gla::hash(v);
+        }
+    };
+}
@@ -0,0 +1,288 @@
+#pragma once
+
+#include "gla.h"
+#include "eigen.h"
+
+/*
+    ┌--------------------------------------------------------------------------┐
+    |                                                                          |
+    | singular value and polar decomposition of 3x3 matrices:                  |
+    |                                                                          |
+    |        m = u * diagonal(sigma) * transpose(v)                            |
+    |        m = rotation * stretch                                            |
+    |                                                                          |
+    | after mcadams et al.: v are the eigenvectors of transpose(m) * m (see    |
+    | eigen.h), then m * v is orthogonalized with three givens rotations,      |
+    | which gives u and sigma as the diagonal of what remains.                 |
+    |                                                                          |
+    | u and v are always rotations. sigma is sorted by magnitude, largest      |
+    | first, and only sigma.z can be negative, which it is when m mirrors      |
+    | (negative determinant). that is what shape matching and corotational     |
+    | elements want: 'rotation' = u * transpose(v) never contains a            |
+    | reflection, the mirroring stays in the symmetric 'stretch'.              |
+    |                                                                          |
+    | going through transpose(m) * m squares the condition number, so the      |
+    | smallest singular value of a nearly flat matrix is only accurate to      |
+    | about epsilon * sigma.x^2 / sigma.z. rotations stay orthonormal to       |
+    | machine precision regardless.                                            |
+    |                                                                          |
+    | the batched versions keep 16 matrices in lanes like eigen_symmetric(),   |
+    | the jacobi sweeps run on all of them at once (four per sse register in   |
+    | float), the givens steps and the sorting then go matrix by matrix.       |
+    |                                                                          |
+    └--------------------------------------------------------------------------┘
+*/
+
+namespace gla
+{
+    template<typename T>
+    struct singular_value_decomposition
+    {
+        mat<3, 3, T> u;
+
+        // largest magnitude first, only the last one can be negative
+        vec<3, T> sigma;
+
+        mat<3, 3, T> v;
+    };
+
+    template<typename T>
+    struct polar_decomposition
+    {
+        // proper rotation
+        mat<3, 3, T> rotation;
+
+        // symmetric
+        mat<3, 3, T> stretch;
+    };
+
+    namespace detail
+    {
+        // rotates rows p and q of b so that b[j][q] becomes zero, u collects the transposed rotations as columns p and q
+        template<typename T>
+        static GLA_CONSTEXPR void givens_orthogonalize(T (&b)[3][3], T (&u)[3][3], int p, int q, int j)
+        {
+            const T a1 = b[j][p];
+            const T a2 = b[j][q];
+
+            const T rho = std::sqrt(a1 * a1 + a2 * a2);
+
+            // nothing to rotate for a zero column
+            const T c = (rho > 0) ? a1 / rho : T(1);
+            const T s = (rho > 0) ? a2 / rho : T(0);
+
+            for (int k = 0; k < 3; k++)
+            {
+                const T bp = b[k][p];
+                const T bq = b[k][q];
+
+                b[k][p] = c * bp + s * bq;
+                b[k][q] = c * bq - s * bp;
+
+                const T up = u[p][k];
+                const T uq = u[q][k];
+
+                u[p][k] = c * up + s * uq;
+                u[q][k] = c * uq - s * up;
+            }
+        }
+
+        // u and sigma from m and the sorted, right-handed eigenvectors v of transpose(m) * m. all arrays are [column][row]
+        template<typename T>
+        static GLA_CONSTEXPR void svd_from_eigenvectors(const T (&m)[3][3], const T (&v)[3][3], T (&u)[3][3], T (&sigma)[3])
+        {
+            T b[3][3] = { };
+
+            for (int c = 0; c < 3; c++)
+            {
+                for (int r = 0; r < 3; r++) b[c][r] = m[0][r] * v[c][0] + m[1][r] * v[c][1] + m[2][r] * v[c][2];
+            }
+
+            for (int c = 0; c < 3; c++) for (int r = 0; r < 3; r++) u[c][r] = (c == r) ? T(1) : T(0);
+
+            givens_orthogonalize(b, u, 0, 1, 0);
+            givens_orthogonalize(b, u, 0, 2, 0);
+            givens_orthogonalize(b, u, 1, 2, 1);
+
+            for (int i = 0; i < 3; i++) sigma[i] = b[i][i];
+        }
+
+        template<typename T>
+        static GLA_CONSTEXPR singular_value_decomposition<T> to_svd(const T (&u)[3][3], const T (&sigma)[3], const T (&v)[3][3])
+        {
+            singular_value_decomposition<T> result;
+
+            result.sigma = vec<3, T>(sigma[0], sigma[1], sigma[2]);
+
+            for (int c = 0; c < 3; c++)
+            {
+                result.u[c] = vec<3, T>(u[c][0], u[c][1], u[c][2]);
+                result.v[c] = vec<3, T>(v[c][0], v[c][1], v[c][2]);
+            }
+
+            return result;
+        }
+
+        template<typename T>
+        static GLA_CONSTEXPR polar_decomposition<T> to_polar(const T (&u)[3][3], const T (&sigma)[3], const T (&v)[3][3])
+        {
+            polar_decomposition<T> result;
+
+            for (int c = 0; c < 3; c++)
+            {
+                for (int r = 0; r < 3; r++)
+                {
+                    result.rotation[c][r] = u[0][r] * v[0][c] + u[1][r] * v[1][c] + u[2][r] * v[2][c];
+                    result.stretch[c][r] = v[0][r] * sigma[0] * v[0][c] + v[1][r] * sigma[1] * v[1][c] + v[2][r] * sigma[2] * v[2][c];
+                }
+            }
+
+            return result;
+        }
+
+        // single matrix version of svd_block()
+        template<typename T>
+        static GLA_CONSTEXPR void svd(const mat<3, 3, T> &m, int sweeps, T (&u)[3][3], T (&sigma)[3], T (&v)[3][3])
+        {
+            // upper triangle of transpose(m) * m, that is all eigen_symmetric() reads
+            mat<3, 3, T> normal;
+
+            for (int c = 0; c < 3; c++)
+            {
+                for (int r = 0; r <= c; r++) normal[c][r] = vec<3, T>::dot(m[r], m[c]);
+            }
+
+            const symmetric_eigen<T> eigen = eigen_symmetric(normal, sweeps);
+
+            T a[3][3] = { };
+
+            for (int c = 0; c < 3; c++)
+            {
+                for (int r = 0; r < 3; r++)
+                {
+                    a[c][r] = m[c][r];
+                    v[c][r] = eigen.vectors[c][r];
+                }
+            }
+
+            svd_from_eigenvectors(a, v, u, sigma);
+        }
+
+        // decomposes up to JACOBI_LANES matrices in lanes and hands every lane's u, sigma and v to 'emit'
+        template<typename T, typename F>
+        static void svd_block(const mat<3, 3, T> *matrices, std::size_t lanes, int sweeps, F &&emit)
+        {
+            const std::size_t W = JACOBI_LANES;
+
+            // upper triangle of transpose(m) * m, a00, a11, a22, a01, a02 and a12 of every lane
+            T a[6][W];
+
+            // v[column][row][lane]
+            T v[3][3][W];
+
+            for (std::size_t l = 0; l < W; l++)
+            {
+                // unused lanes repeat the first matrix of the block
+                const mat<3, 3, T> &m = (l < lanes) ? matrices[l] : matrices[0];
+
+                a[0][l] = vec<3, T>::dot(m[0], m[0]); a[1][l] = vec<3, T>::dot(m[1], m[1]); a[2][l] = vec<3, T>::dot(m[2], m[2]);
+                a[3][l] = vec<3, T>::dot(m[0], m[1]); a[4][l] = vec<3, T>::dot(m[0], m[2]); a[5][l] = vec<3, T>::dot(m[1], m[2]);
+
+                for (int c = 0; c < 3; c++) for (int r = 0; r < 3; r++) v[c][r][l] = (c == r) ? T(1) : T(0);
+            }
+
+            jacobi_sweeps(a, v, sweeps);
+
+            for (std::size_t l = 0; l < lanes; l++)
+            {
+                T values[3] = { a[0][l], a[1][l], a[2][l] };
+                T vectors[3][3];
+                T m[3][3];
+
+                for (int c = 0; c < 3; c++)
+                {
+                    for (int r = 0; r < 3; r++)
+                    {
+                        vectors[c][r] = v[c][r][l];
+                        m[c][r] = matrices[l][c][r];
+                    }
+                }
+
+                sort_eigen(values, vectors);
+
+                T u[3][3];
+                T sigma[3];
+
+                svd_from_eigenvectors(m, vectors, u, sigma);
+
+                emit(l, u, sigma, vectors);
+            }
+        }
+    }
+
+    // ┌----------------------------------------------------┐
+    // │    singular value decomposition                    |
+    // └----------------------------------------------------┘
+
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR singular_value_decomposition<T> svd(const mat<3, 3, T> &m, int sweeps = 6)
+    {
+        GLA_STATIC_ASSERT(std::is_floating_point<T>::value, "function 'svd()' only accepts floating-point value inputs!");
+
+        T u[3][3] = { }, v[3][3] = { };
+        T sigma[3] = { };
+
+        detail::svd(m, sweeps, u, sigma, v);
+
+        return detail::to_svd(u, sigma, v);
+    }
+
+    template<typename T>
+    static void svd(const mat<3, 3, T> *matrices, std::size_t count, singular_value_decomposition<T> *output, int sweeps = 6)
+    {
+        GLA_STATIC_ASSERT(std::is_floating_point<T>::value, "function 'svd()' only accepts floating-point value inputs!");
+
+        GLA_INSTRUMENT_KERNEL("svd", count);
+
+        for (std::size_t first = 0; first < count; first += detail::JACOBI_LANES)
+        {
+            detail::svd_block(matrices + first, std::min(detail::JACOBI_LANES, count - first), sweeps, [&](std::size_t l, const T (&u)[3][3], const T (&sigma)[3], const T (&v)[3][3])
+            {
+                output[first + l] = detail::to_svd(u, sigma, v);
+            });
+        }
+    }
+
+    // ┌----------------------------------------------------┐
+    // │    polar decomposition                             |
+    // └----------------------------------------------------┘
+
+    template<typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR polar_decomposition<T> polar(const mat<3, 3, T> &m, int sweeps = 6)
+    {
+        GLA_STATIC_ASSERT(std::is_floating_point<T>::value, "function 'polar()' only accepts floating-point value inputs!");
+
+        T u[3][3] = { }, v[3][3] = { };
+        T sigma[3] = { };
+
+        detail::svd(m, sweeps, u, sigma, v);
+
+        return detail::to_polar(u, sigma, v);
+    }
+
+    template<typename T>
+    static void polar(const mat<3, 3, T> *matrices, std::size_t count, polar_decomposition<T> *output, int sweeps = 6)
+    {
+        GLA_STATIC_ASSERT(std::is_floating_point<T>::value, "function 'polar()' only accepts floating-point value inputs!");
+
+        GLA_INSTRUMENT_KERNEL("polar", count);
+
+        for (std::size_t first = 0; first < count; first += detail::JACOBI_LANES)
+        {
+            detail::svd_block(matrices + first, std::min(detail::JACOBI_LANES, count - first), sweeps, [&](std::size_t l, const T (&u)[3][3], const T (&sigma)[3], const T (&v)[3][3])
+            {
+                output[first + l] = detail::to_polar(u, sigma, v);
+            });
+        }
+    }
+}
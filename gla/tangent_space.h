@@ -0,0 +1,257 @@
+#pragma once
+
+#include <limits>
+#include <vector>
+
+#include "gla.h"
+#include "parallel.h"
+
+/*
+    ┌--------------------------------------------------------------------------┐
+    |                                                                          |
+    | vertex normals and tangents of indexed triangle meshes:                  |
+    |                                                                          |
+    |   vertex_normals()   sum of the adjacent face normals, weighted by the   |
+    |                      face area or by the angle at the vertex             |
+    |   vertex_tangents()  mikktspace tangents, vec4 ( tangent, sign ) with    |
+    |                      bitangent = sign * cross(normal, tangent)           |
+    |                                                                          |
+    | both run in two passes. the first goes over the triangles and writes     |
+    | one contribution per corner, the second goes over the vertices and       |
+    | sums the contributions of their corners through a vertex_adjacency.      |
+    | every output is written by exactly one thread and corners are summed     |
+    | in triangle order, so the results do not depend on the thread count.     |
+    |                                                                          |
+    | tangents follow mikktspace: per-face tangents from the uv derivatives    |
+    | are projected onto the plane of the vertex normal and weighted by the    |
+    | corner angle in that plane. mikktspace also splits vertices at uv        |
+    | seams and between mirrored and unmirrored faces, meshes that are         |
+    | indexed that way already (as exported for rendering) get the same        |
+    | tangents. a vertex without any uv gradient gets an arbitrary tangent     |
+    | orthogonal to its normal.                                                |
+    |                                                                          |
+    └--------------------------------------------------------------------------┘
+*/
+
+namespace gla
+{
+    enum class normal_weighting
+    {
+        area,
+        angle
+    };
+
+    // the corners (3 * triangle + k) using each vertex, grouped per vertex in triangle order
+    struct vertex_adjacency
+    {
+        // corners of vertex v are corners[offsets[v]] up to corners[offsets[v + 1]]
+        std::vector<std::uint32_t> offsets;
+        std::vector<std::uint32_t> corners;
+
+        vertex_adjacency(const std::uint32_t *indices, std::size_t triangle_count, std::size_t vertex_count)
+            : offsets(vertex_count + 1, 0), corners(3 * triangle_count)
+        {
+            GLA_INSTRUMENT_KERNEL("vertex_adjacency", triangle_count);
+
+            // counting sort of the corners by vertex
+            for (std::size_t c = 0; c < 3 * triangle_count; c++)
+            {
+                GLA_ASSERT(indices[c] < vertex_count, "a triangle index is out of the vertex range!")
+
+                offsets[indices[c] + 1]++;
+            }
+
+            for (std::size_t v = 0; v < vertex_count; v++) offsets[v + 1] += offsets[v];
+
+            std::vector<std::uint32_t> cursor(offsets.begin(), offsets.end() - 1);
+
+            for (std::size_t c = 0; c < 3 * triangle_count; c++)
+            {
+                corners[cursor[indices[c]]++] = static_cast<std::uint32_t>(c);
+            }
+        }
+
+        GLA_NODISCARD std::size_t vertex_count() const
+        {
+            return offsets.size() - 1;
+        }
+    };
+
+    namespace detail
+    {
+        const std::size_t TANGENT_SPACE_GRAIN = 16384;
+
+        // angle between the edges to 'next' and 'previous', robust for very flat corners
+        template<typename T>
+        GLA_NODISCARD static GLA_CONSTEXPR T corner_angle(const vec<3, T> &to_next, const vec<3, T> &to_previous)
+        {
+            return std::atan2(vec<3, T>::cross(to_next, to_previous).length(), vec<3, T>::dot(to_next, to_previous));
+        }
+
+        template<typename T>
+        GLA_NODISCARD static GLA_CONSTEXPR vec<3, T> project_to_plane(const vec<3, T> &v, const vec<3, T> &normal)
+        {
+            return v - normal * vec<3, T>::dot(normal, v);
+        }
+
+        // any unit vector orthogonal to a unit normal
+        template<typename T>
+        GLA_NODISCARD static GLA_CONSTEXPR vec<3, T> orthogonal(const vec<3, T> &normal)
+        {
+            const vec<3, T> axis = (std::abs(normal.x) < std::abs(normal.y))
+                                 ? ((std::abs(normal.x) < std::abs(normal.z)) ? vec<3, T>(1, 0, 0) : vec<3, T>(0, 0, 1))
+                                 : ((std::abs(normal.y) < std::abs(normal.z)) ? vec<3, T>(0, 1, 0) : vec<3, T>(0, 0, 1));
+
+            return vec<3, T>::cross(normal, axis).normalized();
+        }
+    }
+
+    // ┌----------------------------------------------------┐
+    // │    normals                                         |
+    // └----------------------------------------------------┘
+
+    // unit normals, zero for vertices that only touch degenerate triangles (or none)
+    template<typename T>
+    static void vertex_normals(const vec<3, T> *positions, const std::uint32_t *indices, std::size_t triangle_count, const vertex_adjacency &adjacency,
+                               vec<3, T> *normals, normal_weighting weighting = normal_weighting::angle)
+    {
+        GLA_STATIC_ASSERT(std::is_floating_point<T>::value, "function 'vertex_normals()' only accepts floating-point value inputs!");
+
+        GLA_INSTRUMENT_KERNEL("vertex_normals", triangle_count);
+
+        std::vector<vec<3, T>> contributions(3 * triangle_count);
+
+        parallel_for(0, triangle_count, detail::TANGENT_SPACE_GRAIN, [&](std::size_t first, std::size_t last)
+        {
+            for (std::size_t f = first; f < last; f++)
+            {
+                const vec<3, T> p[3] = { positions[indices[3 * f]], positions[indices[3 * f + 1]], positions[indices[3 * f + 2]] };
+
+                // twice the area times the unit normal
+                const vec<3, T> face = vec<3, T>::cross(p[1] - p[0], p[2] - p[0]);
+
+                if (weighting == normal_weighting::area)
+                {
+                    for (int k = 0; k < 3; k++) contributions[3 * f + k] = face;
+
+                    continue;
+                }
+
+                const vec<3, T> unit = face.normalized();
+
+                for (int k = 0; k < 3; k++)
+                {
+                    contributions[3 * f + k] = unit * detail::corner_angle(p[(k + 1) % 3] - p[k], p[(k + 2) % 3] - p[k]);
+                }
+            }
+        });
+
+        parallel_for(0, adjacency.vertex_count(), detail::TANGENT_SPACE_GRAIN, [&](std::size_t first, std::size_t last)
+        {
+            for (std::size_t v = first; v < last; v++)
+            {
+                vec<3, T> sum;
+
+                for (std::uint32_t i = adjacency.offsets[v]; i < adjacency.offsets[v + 1]; i++) sum += contributions[adjacency.corners[i]];
+
+                normals[v] = sum.normalized();
+            }
+        });
+    }
+
+    template<typename T>
+    static void vertex_normals(const vec<3, T> *positions, std::size_t vertex_count, const std::uint32_t *indices, std::size_t triangle_count,
+                               vec<3, T> *normals, normal_weighting weighting = normal_weighting::angle)
+    {
+        vertex_normals(positions, indices, triangle_count, vertex_adjacency(indices, triangle_count, vertex_count), normals, weighting);
+    }
+
+    // ┌----------------------------------------------------┐
+    // │    tangents                                        |
+    // └----------------------------------------------------┘
+
+    // 'normals' are unit vertex normals, for example from vertex_normals()
+    template<typename T>
+    static void vertex_tangents(const vec<3, T> *positions, const vec<2, T> *uvs, const vec<3, T> *normals, const std::uint32_t *indices, std::size_t triangle_count,
+                                const vertex_adjacency &adjacency, vec<4, T> *tangents)
+    {
+        GLA_STATIC_ASSERT(std::is_floating_point<T>::value, "function 'vertex_tangents()' only accepts floating-point value inputs!");
+
+        GLA_INSTRUMENT_KERNEL("vertex_tangents", triangle_count);
+
+        // unit tangent of each face, zero when its uvs are degenerate, with the orientation of the uv mapping in w
+        std::vector<vec<4, T>> faces(triangle_count);
+
+        parallel_for(0, triangle_count, detail::TANGENT_SPACE_GRAIN, [&](std::size_t first, std::size_t last)
+        {
+            for (std::size_t f = first; f < last; f++)
+            {
+                const std::uint32_t i0 = indices[3 * f], i1 = indices[3 * f + 1], i2 = indices[3 * f + 2];
+
+                const vec<3, T> e1 = positions[i1] - positions[i0];
+                const vec<3, T> e2 = positions[i2] - positions[i0];
+
+                const vec<2, T> s1 = uvs[i1] - uvs[i0];
+                const vec<2, T> s2 = uvs[i2] - uvs[i0];
+
+                const T signed_area = s1.x * s2.y - s1.y * s2.x;
+                const T orientation = (signed_area > 0) ? T(1) : T(-1);
+
+                const vec<3, T> os = e1 * s2.y - e2 * s1.y;
+                const T length = os.length();
+
+                const bool valid = std::abs(signed_area) > std::numeric_limits<T>::min() && length > std::numeric_limits<T>::min();
+
+                const vec<3, T> tangent = valid ? os * (orientation / length) : vec<3, T>();
+
+                faces[f] = vec<4, T>(tangent.x, tangent.y, tangent.z, valid ? orientation : T(0));
+            }
+        });
+
+        parallel_for(0, adjacency.vertex_count(), detail::TANGENT_SPACE_GRAIN, [&](std::size_t first, std::size_t last)
+        {
+            for (std::size_t v = first; v < last; v++)
+            {
+                const vec<3, T> &n = normals[v];
+
+                vec<3, T> sum;
+                T orientation = 0;
+
+                for (std::uint32_t i = adjacency.offsets[v]; i < adjacency.offsets[v + 1]; i++)
+                {
+                    const std::uint32_t corner = adjacency.corners[i];
+                    const std::uint32_t f = corner / 3;
+                    const std::uint32_t k = corner % 3;
+
+                    const vec<4, T> &face = faces[f];
+
+                    if (face.w == 0) continue;
+
+                    const vec<3, T> p = positions[v];
+
+                    const vec<3, T> to_next = detail::project_to_plane(positions[indices[3 * f + (k + 1) % 3]] - p, n);
+                    const vec<3, T> to_previous = detail::project_to_plane(positions[indices[3 * f + (k + 2) % 3]] - p, n);
+
+                    const T angle = detail::corner_angle(to_next, to_previous);
+
+                    sum += detail::project_to_plane(vec<3, T>(face.x, face.y, face.z), n).normalized() * angle;
+                    orientation += face.w * angle;
+                }
+
+                // gram-schmidt once more, the sum of in-plane vectors drifts out of the plane by rounding
+                vec<3, T> tangent = detail::project_to_plane(sum, n).normalized();
+
+                if (tangent == vec<3, T>::zero()) tangent = detail::orthogonal(n);
+
+                tangents[v] = vec<4, T>(tangent.x, tangent.y, tangent.z, (orientation < 0) ? T(-1) : T(1));
+            }
+        });
+    }
+
+    template<typename T>
+    static void vertex_tangents(const vec<3, T> *positions, const vec<2, T> *uvs, const vec<3, T> *normals, std::size_t vertex_count,
+                                const std::uint32_t *indices, std::size_t triangle_count, vec<4, T> *tangents)
+    {
+        vertex_tangents(positions, uvs, normals, indices, triangle_count, vertex_adjacency(indices, triangle_count, vertex_count), tangents);
+    }
+}
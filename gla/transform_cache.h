@@ -0,0 +1,346 @@
+#pragma once
+
+#include <list>
+#include <cstring>
+#include <unordered_map>
+
+#include "gla.h"
+
+/*
+    ┌--------------------------------------------------------------------------┐
+    |                                                                          |
+    | opt-in memoization of inverse(), determinant() and products of mat4x4:   |
+    |                                                                          |
+    |   - keyed on content, a hash of the raw matrix values. a hit compares    |
+    |     the stored inputs bit by bit, so a hash collision is only a miss     |
+    |                                                                          |
+    |   - or keyed on a caller-provided (id, version) stamp, for matrices      |
+    |     whose owner already knows when they change. nothing is hashed, a     |
+    |     hit compares the stored stamps, bumping the version invalidates      |
+    |                                                                          |
+    | at most 'capacity' results are kept, the least recently used one is      |
+    | evicted first. a cache is not thread-safe, keep one per thread.          |
+    |                                                                          |
+    └--------------------------------------------------------------------------┘
+*/
+
+namespace gla
+{
+    struct cache_statistics
+    {
+        std::uint64_t hits = 0;
+        std::uint64_t misses = 0;
+        std::uint64_t evictions = 0;
+
+        GLA_NODISCARD double hit_rate() const
+        {
+            return (hits + misses != 0) ? static_cast<double>(hits) / (hits + misses) : 0.0;
+        }
+    };
+
+    template<typename T>
+    struct transform_cache
+    {
+        typedef mat<4, 4, T> matrix;
+
+    private:
+        enum class operation : std::uint64_t
+        {
+            inverse,
+            determinant,
+            multiply
+        };
+
+        // (id, version) of both inputs, the second pair is zero for inverse and determinant
+        struct stamps
+        {
+            std::uint64_t id_a, version_a;
+            std::uint64_t id_b, version_b;
+
+            GLA_NODISCARD bool operator == (const stamps &s) const
+            {
+                return id_a == s.id_a && version_a == s.version_a && id_b == s.id_b && version_b == s.version_b;
+            }
+        };
+
+        struct entry
+        {
+            std::uint64_t key;
+
+            // every entry keeps what it was computed from, so a hit is verified and a key collision is only a miss
+            operation op;
+            bool stamped;
+
+            stamps stamp;
+
+            matrix a;
+            matrix b;
+
+            matrix result;
+            T determinant;
+        };
+
+        typedef typename std::list<entry>::iterator iterator;
+
+        std::size_t capacity;
+
+        // most recently used at the front
+        std::list<entry> entries;
+        std::unordered_map<std::uint64_t, iterator> lookup;
+
+        cache_statistics statistics;
+
+    public:
+        // ┌----------------------------------------------------┐
+        // │    constructors                                    |
+        // └----------------------------------------------------┘
+
+        explicit transform_cache(std::size_t capacity = 256) : capacity(capacity)
+        {
+            GLA_ASSERT(capacity > 0, "a transform cache must be able to hold at least one result!")
+
+            lookup.reserve(capacity);
+        }
+
+        // ┌----------------------------------------------------┐
+        // │    properties                                      |
+        // └----------------------------------------------------┘
+
+        GLA_NODISCARD std::size_t size() const
+        {
+            return entries.size();
+        }
+
+        GLA_NODISCARD const cache_statistics & stats() const
+        {
+            return statistics;
+        }
+
+        void reset_stats()
+        {
+            statistics = { };
+        }
+
+        void clear()
+        {
+            entries.clear();
+            lookup.clear();
+        }
+
+        // ┌----------------------------------------------------┐
+        // │    content-keyed                                   |
+        // └----------------------------------------------------┘
+
+        GLA_NODISCARD matrix inverse(const matrix &m)
+        {
+            const std::uint64_t key = combine(hash(m), operation::inverse);
+
+            entry *e = find(key, operation::inverse, m, m);
+
+            if (e == nullptr)
+            {
+                e = &add(key, operation::inverse, false, stamps(), m, m);
+
+                e->result = m.inverse();
+            }
+
+            return e->result;
+        }
+
+        GLA_NODISCARD T determinant(const matrix &m)
+        {
+            const std::uint64_t key = combine(hash(m), operation::determinant);
+
+            entry *e = find(key, operation::determinant, m, m);
+
+            if (e == nullptr)
+            {
+                e = &add(key, operation::determinant, false, stamps(), m, m);
+
+                e->determinant = m.determinant();
+            }
+
+            return e->determinant;
+        }
+
+        GLA_NODISCARD matrix multiply(const matrix &a, const matrix &b)
+        {
+            const std::uint64_t key = combine(mix(hash(a) ^ (hash(b) * 0x9E3779B97F4A7C15ULL)), operation::multiply);
+
+            entry *e = find(key, operation::multiply, a, b);
+
+            if (e == nullptr)
+            {
+                e = &add(key, operation::multiply, false, stamps(), a, b);
+
+                e->result = a * b;
+            }
+
+            return e->result;
+        }
+
+        // ┌----------------------------------------------------┐
+        // │    version-stamped                                 |
+        // └----------------------------------------------------┘
+
+        GLA_NODISCARD matrix inverse(std::uint64_t id, std::uint64_t version, const matrix &m)
+        {
+            const stamps s = { id, version, 0, 0 };
+            const std::uint64_t key = combine(stamp(id, version), operation::inverse);
+
+            entry *e = find(key, operation::inverse, s);
+
+            if (e == nullptr)
+            {
+                e = &add(key, operation::inverse, true, s, m, m);
+
+                e->result = m.inverse();
+            }
+
+            return e->result;
+        }
+
+        GLA_NODISCARD T determinant(std::uint64_t id, std::uint64_t version, const matrix &m)
+        {
+            const stamps s = { id, version, 0, 0 };
+            const std::uint64_t key = combine(stamp(id, version), operation::determinant);
+
+            entry *e = find(key, operation::determinant, s);
+
+            if (e == nullptr)
+            {
+                e = &add(key, operation::determinant, true, s, m, m);
+
+                e->determinant = m.determinant();
+            }
+
+            return e->determinant;
+        }
+
+        GLA_NODISCARD matrix multiply(std::uint64_t id_a, std::uint64_t version_a, const matrix &a,
+                                      std::uint64_t id_b, std::uint64_t version_b, const matrix &b)
+        {
+            const stamps s = { id_a, version_a, id_b, version_b };
+            const std::uint64_t key = combine(mix(stamp(id_a, version_a) ^ (stamp(id_b, version_b) * 0x9E3779B97F4A7C15ULL)), operation::multiply);
+
+            entry *e = find(key, operation::multiply, s);
+
+            if (e == nullptr)
+            {
+                e = &add(key, operation::multiply, true, s, a, b);
+
+                e->result = a * b;
+            }
+
+            return e->result;
+        }
+
+    private:
+        GLA_NODISCARD static std::uint64_t mix(std::uint64_t h)
+        {
+            h ^= h >> 33;
+            h *= 0xFF51AFD7ED558CCDULL;
+            h ^= h >> 33;
+            h *= 0xC4CEB9FE1A85EC53ULL;
+            h ^= h >> 33;
+
+            return h;
+        }
+
+        // hashes the raw bytes of the values, eight at a time
+        GLA_NODISCARD static std::uint64_t hash(const matrix &m)
+        {
+            GLA_STATIC_ASSERT(sizeof(matrix) % sizeof(std::uint64_t) == 0, "the transform cache hashes matrices as whole 64-bit words!");
+
+            std::uint64_t words[sizeof(matrix) / sizeof(std::uint64_t)];
+
+            std::memcpy(words, &m, sizeof(matrix));
+
+            std::uint64_t h = 0;
+
+            for (std::uint64_t word : words)
+            {
+                h = (h ^ word) * 0x100000001B3ULL;
+                h = (h << 31) | (h >> 33);
+            }
+
+            return mix(h);
+        }
+
+        GLA_NODISCARD static std::uint64_t stamp(std::uint64_t id, std::uint64_t version)
+        {
+            return mix(id * 0x9E3779B97F4A7C15ULL + version);
+        }
+
+        // keeps the three operations on the same input apart
+        GLA_NODISCARD static std::uint64_t combine(std::uint64_t key, operation op)
+        {
+            return mix(key + static_cast<std::uint64_t>(op));
+        }
+
+        GLA_NODISCARD static bool same(const matrix &a, const matrix &b)
+        {
+            return std::memcmp(&a, &b, sizeof(matrix)) == 0;
+        }
+
+        // the content-keyed entry under 'key' if it was computed by 'op' from 'a' and 'b'
+        entry * find(std::uint64_t key, operation op, const matrix &a, const matrix &b)
+        {
+            return find(key, [&](const entry &e) { return e.op == op && !e.stamped && same(e.a, a) && same(e.b, b); });
+        }
+
+        // the version-stamped entry under 'key' if it was computed by 'op' from the inputs stamped 's'
+        entry * find(std::uint64_t key, operation op, const stamps &s)
+        {
+            return find(key, [&](const entry &e) { return e.op == op && e.stamped && e.stamp == s; });
+        }
+
+        // the entry under 'key' if 'matches' accepts it, moved to the front
+        template<typename F>
+        entry * find(std::uint64_t key, F &&matches)
+        {
+            const auto found = lookup.find(key);
+
+            if (found == lookup.end())
+            {
+                statistics.misses++;
+
+                return nullptr;
+            }
+
+            if (!matches(*found->second))
+            {
+                // a collision, the caller replaces the entry
+                entries.erase(found->second);
+                lookup.erase(found);
+
+                statistics.misses++;
+
+                return nullptr;
+            }
+
+            entries.splice(entries.begin(), entries, found->second);
+
+            statistics.hits++;
+
+            return &entries.front();
+        }
+
+        entry & add(std::uint64_t key, operation op, bool stamped, const stamps &s, const matrix &a, const matrix &b)
+        {
+            if (entries.size() >= capacity)
+            {
+                lookup.erase(entries.back().key);
+                entries.pop_back();
+
+                statistics.evictions++;
+            }
+
+            entries.push_front({ key, op, stamped, s, a, b, matrix(), 0 });
+
+            lookup[key] = entries.begin();
+
+            return entries.front();
+        }
+    };
+}
@@ -0,0 +1,2089 @@
+#pragma once
+
+#include <cfloat>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <iomanip>
+#include <utility>
+#include <algorithm>
+
+#include "gla.h"
+#include "obb.h"
+#include "svd.h"
+#include "eigen.h"
+#include "viewport.h"
+#include "skinning.h"
+#include "particles.h"
+#include "rasterizer.h"
+#include "compression.h"
+#include "linear_solve.h"
+#include "spatial_hash.h"
+#include "matrix_layout.h"
+#include "space_filling.h"
+#include "tangent_space.h"
+#include "transform_cache.h"
+#include "dual_quaternion.h"
+#include "vector_relational.h"
+
+/*
+    ┌--------------------------------------------------------------------------┐
+    |                                                                          |
+    | differential validation, a candidate kernel against a reference:         |
+    |                                                                          |
+    |   - float code against the same code in double (the reference loops)     |
+    |   - sse kernels against their scalar template versions                   |
+    |                                                                          |
+    | errors are measured in units in the last place of the candidate type,    |
+    | of a scale per component, against the reference rounded to that type.    |
+    | the scale is the largest reference component of the sample (normwise),   |
+    | so a cancelling sum is not held to its own tiny magnitude. a kernel      |
+    | whose components live on different scales gives per-component floors     |
+    | instead, and a sample can raise its scale to the size of the terms       |
+    | that cancelled (see scaled). the printed max, mean and relative errors   |
+    | are the same figures the verdict uses. a non-finite result where the     |
+    | reference is finite (or the other way around) always fails.              |
+    |                                                                          |
+    | inputs are drawn per class:                                              |
+    |                                                                          |
+    |   uniform       well-conditioned values around one                       |
+    |   denormal      subnormal and barely normal values                       |
+    |   huge          the top four decades below (FLT_MAX / 32)^(1 / degree),  |
+    |                 so the products of a degree-'degree' kernel stay finite  |
+    |   degenerate    near-singular matrices, near-zero vectors, arguments     |
+    |                 next to the poles of cotan                               |
+    |                                                                          |
+    | every class has a bound. the adversarial ones get a loose one, 64 times  |
+    | the uniform bound unless the kernel sets its own, so they catch results  |
+    | that are wildly off rather than rounding.                                |
+    |                                                                          |
+    | run_all() covers the matrix and projection kernels, both skinning        |
+    | paths, the vec4 comparisons, the batched store of stored_mat, the        |
+    | normal and position compression and the particle integrators.            |
+    |                                                                          |
+    | kernels without a double reference are checked for properties on         |
+    | uniform inputs instead (see holds): the backward error of the solvers,   |
+    | reconstruction, orthonormality and order of eigen, svd and polar, unit   |
+    | and perpendicular tangent frames, clipped vertices inside the frustum.   |
+    | the exact ones compare: obb overlap against boxes placed apart or into   |
+    | each other, morton keys against plain bit interleaving, hilbert          |
+    | adjacency, radix_sort against std::stable_sort, a mesh tiling the        |
+    | screen shading each pixel once, the spatial hash against brute force,    |
+    | the transform cache against direct computation and every batched         |
+    | kernel against its single version.                                       |
+    |                                                                          |
+    | the sse comparisons with a zero bound assume the compiler does not       |
+    | contract a * b + c into fused multiply-adds of its own, build them       |
+    | with -ffp-contract=off. tests/validate.cpp is the runner, registered     |
+    | with ctest by the top-level CMakeLists.txt.                              |
+    |                                                                          |
+    └--------------------------------------------------------------------------┘
+*/
+
+namespace gla
+{
+    namespace validate
+    {
+        enum class input_class
+        {
+            uniform,
+            denormal,
+            huge,
+            degenerate
+        };
+
+        inline const char * to_string(input_class inputs)
+        {
+            switch (inputs)
+            {
+                case input_class::uniform:      return "uniform";
+                case input_class::denormal:     return "denormal";
+                case input_class::huge:         return "huge";
+                default:                        return "degenerate";
+            }
+        }
+
+        // ┌----------------------------------------------------┐
+        // │    ulp distance                                    |
+        // └----------------------------------------------------┘
+
+        // the gap between 'value' and the next representable value away from zero
+        template<typename T>
+        GLA_NODISCARD static T ulp(T value)
+        {
+            value = std::abs(value);
+
+            return std::nextafter(value, std::numeric_limits<T>::infinity()) - value;
+        }
+
+        // allowed errors in ulps, for the uniform class and for the three adversarial ones
+        struct bounds
+        {
+            double uniform;
+            double adversarial;
+
+            // the adversarial classes lose more to cancellation and conditioning, by default they get 64 times the room
+            bounds(double uniform) : uniform(uniform), adversarial(std::max(uniform, 1.0) * 64) { }
+
+            bounds(double uniform, double adversarial) : uniform(uniform), adversarial(adversarial) { }
+        };
+
+        // ┌----------------------------------------------------┐
+        // │    reports                                         |
+        // └----------------------------------------------------┘
+
+        struct report
+        {
+            std::string name;
+            input_class inputs = input_class::uniform;
+
+            // allowed error, in ulps of the scale each component is measured against
+            double ulp_bound = 0;
+
+            // empty: every component is measured against the largest reference component of its sample. otherwise
+            // component i against its own magnitude, but at least scale_floors[i % size], for results whose
+            // components live on different scales or cancel down to zero
+            std::vector<double> scale_floors;
+
+            std::size_t samples = 0;
+            std::size_t components = 0;
+            std::size_t failures = 0;
+
+            // the worst and the mean error in ulps of the scale, and the sample of the worst
+            double max_ulp = 0;
+            double sum_ulp = 0;
+            std::size_t worst_sample = 0;
+
+            // the worst error relative to the scale
+            double max_relative = 0;
+
+            // component index within the current sample, and the smallest scale the sample sets for itself (see scaled)
+            std::size_t component = 0;
+            double sample_floor = 0;
+
+            GLA_NODISCARD bool passed() const
+            {
+                return failures == 0;
+            }
+
+            GLA_NODISCARD double mean_ulp() const
+            {
+                return (components != 0) ? sum_ulp / components : 0.0;
+            }
+
+            // one component of one sample, 'scale' is the largest reference component of that sample
+            template<typename T>
+            void add(double reference, T candidate, double scale)
+            {
+                const std::size_t index = component++;
+
+                components++;
+
+                // the reference in the candidate type, so its own rounding is not counted
+                const T rounded = static_cast<T>(reference);
+
+                const bool finite_reference = std::isfinite(rounded);
+                const bool finite_candidate = std::isfinite(candidate);
+
+                if (finite_reference != finite_candidate)
+                {
+                    record(std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity());
+
+                    return;
+                }
+
+                if (!finite_reference) return;
+
+                if (!scale_floors.empty()) scale = std::max(std::abs(static_cast<double>(rounded)), scale_floors[index % scale_floors.size()]);
+
+                scale = std::min(std::max(scale, sample_floor), static_cast<double>(std::numeric_limits<T>::max()));
+
+                const double error = std::abs(static_cast<double>(candidate) - static_cast<double>(rounded));
+
+                record(error / static_cast<double>(ulp(static_cast<T>(scale))), (scale > 0) ? error / scale : error);
+            }
+
+            void next_sample()
+            {
+                samples++;
+                component = 0;
+                sample_floor = 0;
+            }
+
+        private:
+            void record(double ulps, double relative)
+            {
+                if (ulps > max_ulp)
+                {
+                    max_ulp = ulps;
+                    worst_sample = samples;
+                }
+
+                sum_ulp += std::min(ulps, 4294967296.0);
+                max_relative = std::max(max_relative, relative);
+
+                if (ulps > ulp_bound) failures++;
+            }
+        };
+
+        inline std::ostream & operator<<(std::ostream &out, const report &r)
+        {
+            out << "  " << std::left << std::setw(32) << r.name << std::setw(12) << to_string(r.inputs)
+                << std::right << std::setw(8) << r.samples << " samples   max " << std::setw(10) << std::setprecision(3) << r.max_ulp
+                << " ulp   mean " << std::setw(10) << std::setprecision(3) << r.mean_ulp()
+                << " ulp   max rel " << std::setw(10) << std::setprecision(3) << r.max_relative
+                << "   bound " << std::setw(8) << r.ulp_bound << "   " << (r.passed() ? "ok" : "FAILED");
+
+            if (!r.passed()) out << " (" << r.failures << " failures, worst sample " << r.worst_sample << ")";
+
+            return out;
+        }
+
+        // a result and the smallest scale to measure its error against, for results that cancel: the size of the terms
+        // that cancelled comes from the inputs, the result alone cannot tell it
+        template<typename V>
+        struct scaled
+        {
+            V value;
+            double scale;
+        };
+
+        template<typename V>
+        GLA_NODISCARD static scaled<V> with_scale(const V &value, double scale)
+        {
+            return { value, scale };
+        }
+
+        // ┌----------------------------------------------------┐
+        // │    inputs                                          |
+        // └----------------------------------------------------┘
+
+        struct generator
+        {
+            std::mt19937_64 engine;
+
+            explicit generator(std::uint64_t seed) : engine(seed) { }
+
+            GLA_NODISCARD float uniform(float min, float max)
+            {
+                return std::uniform_real_distribution<float>(min, max)(engine);
+            }
+
+            GLA_NODISCARD float sign()
+            {
+                return (engine() & 1) ? 1.0F : -1.0F;
+            }
+
+            // 'degree' is the number of inputs the kernel multiplies together, see 'huge'
+            GLA_NODISCARD float scalar(input_class inputs, int degree = 1)
+            {
+                switch (inputs)
+                {
+                    case input_class::uniform:
+                        return uniform(-8, 8);
+
+                    case input_class::denormal:
+                        // half subnormal, half within a few binades above FLT_MIN
+                        return sign() * ((engine() & 1) ? uniform(0, 1) * FLT_MIN : uniform(1, 64) * FLT_MIN);
+
+                    case input_class::huge:
+                        // the top four decades below the largest magnitude whose products still fit into float
+                        return sign() * std::pow(FLT_MAX / 32, 1.0F / static_cast<float>(degree)) * std::pow(10.0F, uniform(-4, 0));
+
+                    default:
+                        return sign() * std::pow(10.0F, uniform(-7, -3));
+                }
+            }
+
+            template<std::size_t D>
+            GLA_NODISCARD vec<D, float> vector(input_class inputs, int degree = 1)
+            {
+                vec<D, float> result;
+
+                for (std::size_t i = 0; i < D; i++) result[i] = scalar(inputs, degree);
+
+                return result;
+            }
+
+            GLA_NODISCARD mat4x4 matrix(input_class inputs, int degree = 1)
+            {
+                mat4x4 result;
+
+                if (inputs != input_class::huge)
+                {
+                    // diagonally dominant, so well-conditioned
+                    for (int c = 0; c < 4; c++) for (int r = 0; r < 4; r++) result[c][r] = uniform(-1, 1) + ((c == r) ? 4.0F : 0.0F);
+
+                    if (inputs == input_class::denormal)
+                    {
+                        // subnormal entries off the diagonal, an all-subnormal matrix would just be singular
+                        for (int c = 0; c < 4; c++) for (int r = 0; r < 4; r++) if (c != r && (engine() & 1)) result[c][r] = scalar(inputs);
+                    }
+
+                    if (inputs == input_class::degenerate)
+                    {
+                        // the last column nearly a combination of the others
+                        result[3] = result[0] * uniform(-1, 1) + result[1] * uniform(-1, 1) + result[2] * uniform(-1, 1) + vector<4>(input_class::degenerate);
+                    }
+                }
+                else
+                {
+                    for (int c = 0; c < 4; c++) result[c] = vector<4>(inputs, degree);
+                }
+
+                return result;
+            }
+
+            // below one, 'spread' keeps the rotation near the identity
+            GLA_NODISCARD mat3x3 rotation(float spread = 1)
+            {
+                const vec4 q = vec4(uniform(- spread, spread), uniform(- spread, spread), uniform(- spread, spread), uniform(1 - 2 * spread, 1)).normalized();
+
+                return rotation_matrix(q);
+            }
+
+            // rotation and translation, the bottom row is [ 0 0 0 1 ]
+            GLA_NODISCARD mat4x4 rigid(input_class inputs, float spread = 1)
+            {
+                const mat3x3 r = rotation(spread);
+                const vec3 translation = vector<3>(inputs);
+
+                mat4x4 result = mat4x4::identity();
+
+                for (int c = 0; c < 3; c++) result[c] = vec4(r[c].x, r[c].y, r[c].z, 0);
+
+                result[3] = vec4(translation.x, translation.y, translation.z, 1);
+
+                return result;
+            }
+        };
+
+        // ┌----------------------------------------------------┐
+        // │    comparison                                      |
+        // └----------------------------------------------------┘
+
+        namespace detail
+        {
+            template<typename R, typename T>
+            static void accumulate(report &r, R reference, T candidate)
+            {
+                r.add(static_cast<double>(reference), candidate, std::abs(static_cast<double>(reference)));
+            }
+
+            template<std::size_t D, typename R, typename T>
+            static void accumulate(report &r, const vec<D, R> &reference, const vec<D, T> &candidate)
+            {
+                double scale = 0;
+
+                for (std::size_t i = 0; i < D; i++) scale = std::max(scale, std::abs(static_cast<double>(reference[i])));
+
+                for (std::size_t i = 0; i < D; i++) r.add(static_cast<double>(reference[i]), candidate[i], scale);
+            }
+
+            template<std::size_t C, std::size_t R, typename U, typename T>
+            static void accumulate(report &r, const mat<C, R, U> &reference, const mat<C, R, T> &candidate)
+            {
+                double scale = 0;
+
+                for (std::size_t c = 0; c < C; c++) for (std::size_t i = 0; i < R; i++) scale = std::max(scale, std::abs(static_cast<double>(reference[c][i])));
+
+                for (std::size_t c = 0; c < C; c++) for (std::size_t i = 0; i < R; i++) r.add(static_cast<double>(reference[c][i]), candidate[c][i], scale);
+            }
+
+            // both halves, each normwise on its own
+            template<typename A, typename B, typename U, typename V>
+            static void accumulate(report &r, const std::pair<A, B> &reference, const std::pair<U, V> &candidate)
+            {
+                accumulate(r, reference.first, candidate.first);
+                accumulate(r, reference.second, candidate.second);
+            }
+
+            // normwise over the whole array
+            template<typename U, typename T>
+            static void accumulate(report &r, const std::vector<U> &reference, const std::vector<T> &candidate)
+            {
+                double scale = 0;
+
+                for (const U &value : reference) scale = std::max(scale, std::abs(static_cast<double>(value)));
+
+                for (std::size_t i = 0; i < reference.size(); i++) r.add(static_cast<double>(reference[i]), candidate[i], scale);
+            }
+
+            template<typename U, typename V>
+            static void accumulate(report &r, const scaled<U> &reference, const scaled<V> &candidate)
+            {
+                r.sample_floor = std::max(r.sample_floor, reference.scale);
+
+                accumulate(r, reference.value, candidate.value);
+            }
+
+            // one bit per comparison function and lane, so a whole mask compares as exact integers
+            GLA_NODISCARD inline vec4 mask_bits(const bvec4 (&masks)[7])
+            {
+                vec4 result;
+
+                for (int i = 0; i < 4; i++) for (int k = 0; k < 7; k++) result[i] += masks[k][i] ? static_cast<float>(1 << k) : 0.0F;
+
+                return result;
+            }
+
+            template<std::size_t D>
+            GLA_NODISCARD static vec<D, double> widen(const vec<D, float> &v)
+            {
+                vec<D, double> result;
+
+                for (std::size_t i = 0; i < D; i++) result[i] = v[i];
+
+                return result;
+            }
+
+            GLA_NODISCARD inline dmat4x4 widen(const mat4x4 &m)
+            {
+                dmat4x4 result;
+
+                for (int c = 0; c < 4; c++) result[c] = widen(m[c]);
+
+                return result;
+            }
+
+            GLA_NODISCARD inline dmat3x3 widen(const mat3x3 &m)
+            {
+                dmat3x3 result;
+
+                for (int c = 0; c < 3; c++) result[c] = widen(m[c]);
+
+                return result;
+            }
+
+            // the product of the column lengths, the largest determinant columns of those lengths can have
+            GLA_NODISCARD inline double hadamard(const mat4x4 &m)
+            {
+                double product = 1;
+
+                for (int c = 0; c < 4; c++) product *= widen(m[c]).length();
+
+                return product;
+            }
+
+            // the largest translation of a rigid transform, at least one for the rotation
+            GLA_NODISCARD inline double extent(const mat4x4 &m)
+            {
+                return std::max({ 1.0, std::abs(static_cast<double>(m[3].x)), std::abs(static_cast<double>(m[3].y)), std::abs(static_cast<double>(m[3].z)) });
+            }
+
+            GLA_NODISCARD inline double extent(const std::pair<mat4x4, mat4x4> &m)
+            {
+                return std::max(extent(m.first), extent(m.second));
+            }
+
+            GLA_NODISCARD inline std::vector<float> flatten(const std::vector<vec3> &v)
+            {
+                std::vector<float> result;
+
+                for (const vec3 &x : v) result.insert(result.end(), { x.x, x.y, x.z });
+
+                return result;
+            }
+
+            // ┌----------------------------------------------------┐
+            // │    kernel inputs                                   |
+            // └----------------------------------------------------┘
+
+            struct skinning_input
+            {
+                dualquat palette[4];
+
+                vec3 position;
+                vec3 normal;
+
+                uivec4 joints = uivec4(0, 1, 2, 3);
+                vec4 weights;
+
+                // the largest translation or position, what cancels in the skinned position
+                double extent = 1;
+            };
+
+            GLA_NODISCARD inline std::vector<vec3> unit_vectors(generator &g, input_class inputs)
+            {
+                std::vector<vec3> result(8);
+
+                for (vec3 &v : result)
+                {
+                    v = g.vector<3>(inputs);
+
+                    v = (v != vec3::zero()) ? v.normalized() : vec3(0, 0, 1);
+                }
+
+                return result;
+            }
+
+            // the codes as doubles, which hold every uint32 exactly
+            template<typename F>
+            GLA_NODISCARD static std::vector<double> encode(const std::vector<vec3> &normals, F &&kernel)
+            {
+                std::vector<std::uint32_t> codes(normals.size());
+
+                kernel(normals.data(), normals.size(), codes.data());
+
+                return std::vector<double>(codes.begin(), codes.end());
+            }
+
+            struct position_input
+            {
+                std::vector<vec3> positions;
+
+                vec3 lowest;
+                vec3 highest;
+
+                std::vector<std::uint32_t> cells;
+            };
+
+            // a box of the class's magnitude, at least one wide so the cells stay finite, with some positions outside to be clamped
+            GLA_NODISCARD inline position_input positions(generator &g, input_class inputs)
+            {
+                position_input result;
+
+                for (int k = 0; k < 3; k++)
+                {
+                    const float extent = std::max(std::abs(g.scalar(inputs)), 1.0F);
+
+                    result.lowest[k] = - extent;
+                    result.highest[k] = extent;
+                }
+
+                result.positions.resize(8);
+
+                for (vec3 &p : result.positions) p = g.vector<3>(inputs);
+
+                return result;
+            }
+
+            template<typename F>
+            GLA_NODISCARD static std::vector<double> quantize(const position_input &input, F &&kernel)
+            {
+                std::vector<std::uint32_t> cells(3 * input.positions.size());
+
+                kernel(cells.data());
+
+                return std::vector<double>(cells.begin(), cells.end());
+            }
+
+            // x, y and z of every stream one after the other
+            struct particle_input
+            {
+                std::vector<float> position;
+                std::vector<float> velocity;
+                std::vector<float> acceleration;
+                std::vector<float> damping;
+
+                particle_step<float> step;
+            };
+
+            GLA_NODISCARD inline particle_input particles(generator &g, input_class inputs)
+            {
+                const std::size_t count = 7;
+
+                particle_input result;
+
+                for (std::vector<float> *stream : { &result.position, &result.velocity, &result.acceleration })
+                {
+                    stream->resize(3 * count);
+
+                    for (float &value : *stream) value = g.scalar(inputs);
+                }
+
+                result.damping.resize(count);
+
+                for (float &value : result.damping) value = g.uniform(0, 2);
+
+                result.step.bounded = (g.engine() & 1) != 0;
+
+                const float bound = std::abs(g.scalar(inputs));
+
+                result.step.lowest = vec3(- bound);
+                result.step.highest = vec3(bound);
+
+                return result;
+            }
+
+            // the positions and then the second stream after one step of 'kernel'
+            template<typename F>
+            GLA_NODISCARD static std::vector<float> integrate(const particle_input &input, F &&kernel)
+            {
+                const std::size_t count = input.damping.size();
+
+                std::vector<float> p = input.position;
+                std::vector<float> v = input.velocity;
+
+                const float *a = input.acceleration.data();
+
+                kernel(stream3<float>(&p[0], &p[count], &p[2 * count]), stream3<float>(&v[0], &v[count], &v[2 * count]),
+                       stream3<const float>(a, a + count, a + 2 * count), input.damping.data(), count, input.step);
+
+                p.insert(p.end(), v.begin(), v.end());
+
+                return p;
+            }
+        }
+
+        // runs 'samples' inputs from 'generate(generator &)' through both kernels and compares the results, see report
+        // for 'scale_floors'
+        template<typename G, typename R, typename C>
+        static report compare(const std::string &name, input_class inputs, std::size_t samples, const bounds &bound, std::uint64_t seed,
+                              G &&generate, R &&reference, C &&candidate, std::vector<double> scale_floors = { })
+        {
+            report r;
+
+            r.name = name;
+            r.inputs = inputs;
+            r.ulp_bound = (inputs == input_class::uniform) ? bound.uniform : bound.adversarial;
+            r.scale_floors = std::move(scale_floors);
+
+            generator g(seed);
+
+            for (std::size_t i = 0; i < samples; i++)
+            {
+                const auto input = generate(g);
+
+                detail::accumulate(r, reference(input), candidate(input));
+
+                r.next_sample();
+            }
+
+            return r;
+        }
+
+        // ┌----------------------------------------------------┐
+        // │    properties                                      |
+        // └----------------------------------------------------┘
+
+        namespace detail
+        {
+            // residuals are computed in double from the float results, so only the kernel's own error is measured
+
+            template<std::size_t N>
+            GLA_NODISCARD static vec<N, double> apply(const mat<N, N, double> &m, const vec<N, double> &x)
+            {
+                vec<N, double> result;
+
+                for (std::size_t c = 0; c < N; c++) for (std::size_t r = 0; r < N; r++) result[r] += m[c][r] * x[c];
+
+                return result;
+            }
+
+            template<std::size_t N>
+            static void append(std::vector<double> &residuals, const mat<N, N, double> &m, double scale)
+            {
+                for (std::size_t c = 0; c < N; c++) for (std::size_t r = 0; r < N; r++) residuals.push_back(m[c][r] / scale);
+            }
+
+            GLA_NODISCARD inline dmat3x3 diagonal(const vec3 &v)
+            {
+                dmat3x3 result;
+
+                for (int i = 0; i < 3; i++) result[i][i] = v[i];
+
+                return result;
+            }
+
+            // transpose(m) * m - identity, zero for orthonormal columns
+            GLA_NODISCARD inline dmat3x3 orthonormality(const mat3x3 &m)
+            {
+                const dmat3x3 w = widen(m);
+
+                return w.transpose() * w - dmat3x3::identity();
+            }
+
+            // ┌----------------------------------------------------┐
+            // │    solvers                                         |
+            // └----------------------------------------------------┘
+
+            // a * x - b over the largest row of |a| * |x| + |b|, the normwise backward error of the solve
+            GLA_NODISCARD inline std::vector<double> solve_residuals(const mat4x4 &a, const vec4 &b, const vec4 &x)
+            {
+                const dvec4 residual = apply(widen(a), widen(x)) - widen(b);
+
+                double size = 0;
+
+                for (int r = 0; r < 4; r++)
+                {
+                    double row = std::abs(static_cast<double>(b[r]));
+
+                    for (int c = 0; c < 4; c++) row += std::abs(static_cast<double>(a[c][r]) * x[c]);
+
+                    size = std::max(size, row);
+                }
+
+                return { residual.x / size, residual.y / size, residual.z / size, residual.w / size };
+            }
+
+            GLA_NODISCARD inline mat4x4 positive_definite(generator &g)
+            {
+                const mat4x4 m = g.matrix(input_class::uniform);
+
+                // every product is formed in the same order on both sides of the diagonal, so the result is exactly symmetric
+                return m.transpose() * m;
+            }
+
+            // every fifth system fails with 'failure': singular (a zero row) for lu, indefinite (negated) for cholesky
+            struct system_batch
+            {
+                std::vector<mat4x4> a;
+                std::vector<vec4> b;
+
+                std::vector<bool> regular;
+            };
+
+            GLA_NODISCARD inline system_batch systems(generator &g, solve_status failure)
+            {
+                system_batch result;
+
+                // two full soa blocks and a tail
+                for (std::size_t i = 0; i < 37; i++)
+                {
+                    mat4x4 a = (failure == solve_status::not_positive_definite) ? positive_definite(g) : g.matrix(input_class::uniform);
+
+                    const bool regular = (i % 5 != 0);
+
+                    if (!regular && failure == solve_status::not_positive_definite) a = a * -1.0F;
+
+                    if (!regular && failure == solve_status::near_singular)
+                    {
+                        const std::size_t row = g.engine() % 4;
+
+                        for (int c = 0; c < 4; c++) a[c][row] = 0;
+                    }
+
+                    result.a.push_back(a);
+                    result.b.push_back(g.vector<4>(input_class::uniform));
+                    result.regular.push_back(regular);
+                }
+
+                return result;
+            }
+
+            // the solutions and then the statuses, as doubles
+            GLA_NODISCARD inline std::vector<double> solutions(const std::vector<vec4> &x, const std::vector<solve_status> &status)
+            {
+                std::vector<double> result;
+
+                for (const vec4 &v : x) result.insert(result.end(), { v.x, v.y, v.z, v.w });
+
+                for (solve_status s : status) result.push_back(static_cast<double>(static_cast<int>(s)));
+
+                return result;
+            }
+
+            // the scalar solve of every regular system, a zero solution and the expected status for the others
+            template<typename S>
+            GLA_NODISCARD static std::vector<double> expected_solutions(const system_batch &input, solve_status failure, S &&solve)
+            {
+                std::vector<vec4> x(input.a.size());
+                std::vector<solve_status> status(input.a.size(), failure);
+
+                for (std::size_t i = 0; i < input.a.size(); i++)
+                {
+                    if (input.regular[i]) status[i] = solve(input.a[i], input.b[i], x[i]);
+                }
+
+                return solutions(x, status);
+            }
+
+            // the batch through a soa kernel, a[column * 4 + row][system] as solve_lu() expects
+            template<typename S>
+            GLA_NODISCARD static std::vector<double> soa_solutions(const system_batch &input, S &&solve)
+            {
+                const std::size_t count = input.a.size();
+
+                std::vector<std::vector<float>> a(16, std::vector<float>(count)), b(4, std::vector<float>(count)), x(4, std::vector<float>(count));
+
+                for (std::size_t i = 0; i < count; i++)
+                {
+                    for (int c = 0; c < 4; c++) for (int r = 0; r < 4; r++) a[c * 4 + r][i] = input.a[i][c][r];
+
+                    for (int r = 0; r < 4; r++) b[r][i] = input.b[i][r];
+                }
+
+                const float *a_streams[16];
+                const float *b_streams[4];
+                float *x_streams[4];
+
+                for (int k = 0; k < 16; k++) a_streams[k] = a[k].data();
+                for (int k = 0; k < 4; k++) b_streams[k] = b[k].data();
+                for (int k = 0; k < 4; k++) x_streams[k] = x[k].data();
+
+                std::vector<solve_status> status(count);
+
+                solve(a_streams, b_streams, count, x_streams, status.data());
+
+                std::vector<vec4> solution(count);
+
+                for (std::size_t i = 0; i < count; i++) solution[i] = vec4(x[0][i], x[1][i], x[2][i], x[3][i]);
+
+                return solutions(solution, status);
+            }
+
+            // ┌----------------------------------------------------┐
+            // │    decompositions                                  |
+            // └----------------------------------------------------┘
+
+            GLA_NODISCARD inline mat3x3 symmetric(generator &g)
+            {
+                mat3x3 result;
+
+                for (int c = 0; c < 3; c++) for (int r = c; r < 3; r++) result[c][r] = result[r][c] = g.scalar(input_class::uniform);
+
+                return result;
+            }
+
+            GLA_NODISCARD inline mat3x3 general(generator &g)
+            {
+                mat3x3 result;
+
+                for (int c = 0; c < 3; c++) result[c] = g.vector<3>(input_class::uniform);
+
+                return result;
+            }
+
+            // 21 matrices, a full block of 16 lanes and a tail
+            template<typename F>
+            GLA_NODISCARD static std::vector<mat3x3> matrices(generator &g, F &&draw)
+            {
+                std::vector<mat3x3> result(21);
+
+                for (mat3x3 &m : result) m = draw(g);
+
+                return result;
+            }
+
+            template<std::size_t C, std::size_t R>
+            static void append(std::vector<float> &values, const mat<C, R, float> &m)
+            {
+                for (std::size_t c = 0; c < C; c++) for (std::size_t r = 0; r < R; r++) values.push_back(m[c][r]);
+            }
+
+            inline void append(std::vector<float> &values, const vec3 &v)
+            {
+                values.insert(values.end(), { v.x, v.y, v.z });
+            }
+
+            GLA_NODISCARD inline std::vector<float> flatten(const std::vector<symmetric_eigen<float>> &e)
+            {
+                std::vector<float> result;
+
+                for (const symmetric_eigen<float> &x : e) { append(result, x.values); append(result, x.vectors); }
+
+                return result;
+            }
+
+            GLA_NODISCARD inline std::vector<float> flatten(const std::vector<singular_value_decomposition<float>> &d)
+            {
+                std::vector<float> result;
+
+                for (const singular_value_decomposition<float> &x : d) { append(result, x.u); append(result, x.sigma); append(result, x.v); }
+
+                return result;
+            }
+
+            GLA_NODISCARD inline std::vector<float> flatten(const std::vector<polar_decomposition<float>> &d)
+            {
+                std::vector<float> result;
+
+                for (const polar_decomposition<float> &x : d) { append(result, x.rotation); append(result, x.stretch); }
+
+                return result;
+            }
+
+            // reconstruction over the largest eigenvalue, orthonormality, order and handedness
+            GLA_NODISCARD inline std::vector<double> eigen_residuals(const mat3x3 &m)
+            {
+                const symmetric_eigen<float> e = eigen_symmetric(m);
+
+                const dmat3x3 v = widen(e.vectors);
+                const double scale = std::max({ std::abs(static_cast<double>(e.values.x)), std::abs(static_cast<double>(e.values.y)),
+                                                std::abs(static_cast<double>(e.values.z)), DBL_MIN });
+
+                std::vector<double> result;
+
+                append(result, v * diagonal(e.values) * v.transpose() - widen(m), scale);
+                append(result, orthonormality(e.vectors), 1);
+
+                result.push_back(std::max(0.0, static_cast<double>(e.values.y) - e.values.x) / scale);
+                result.push_back(std::max(0.0, static_cast<double>(e.values.z) - e.values.y) / scale);
+
+                result.push_back(v.determinant() - 1);
+
+                return result;
+            }
+
+            // reconstruction over the largest singular value, u and v rotations, sigma sorted by magnitude and only sigma.z negative
+            GLA_NODISCARD inline std::vector<double> svd_residuals(const mat3x3 &m)
+            {
+                const singular_value_decomposition<float> d = svd(m);
+
+                const dvec3 sigma = widen(d.sigma);
+                const double scale = std::max(std::abs(sigma.x), DBL_MIN);
+
+                std::vector<double> result;
+
+                append(result, widen(d.u) * diagonal(d.sigma) * widen(d.v).transpose() - widen(m), scale);
+                append(result, orthonormality(d.u), 1);
+                append(result, orthonormality(d.v), 1);
+
+                result.push_back(widen(d.u).determinant() - 1);
+                result.push_back(widen(d.v).determinant() - 1);
+
+                result.push_back(std::max(0.0, std::abs(sigma.y) - std::abs(sigma.x)) / scale);
+                result.push_back(std::max(0.0, std::abs(sigma.z) - std::abs(sigma.y)) / scale);
+                result.push_back(std::max(0.0, - sigma.x) / scale);
+                result.push_back(std::max(0.0, - sigma.y) / scale);
+
+                return result;
+            }
+
+            // reconstruction and the symmetry of the stretch over the largest entry, a proper rotation
+            GLA_NODISCARD inline std::vector<double> polar_residuals(const mat3x3 &m)
+            {
+                const polar_decomposition<float> d = polar(m);
+
+                const dmat3x3 stretch = widen(d.stretch);
+                const double scale = std::max(gla::detail::largest_entry(widen(m)), DBL_MIN);
+
+                std::vector<double> result;
+
+                append(result, widen(d.rotation) * stretch - widen(m), scale);
+                append(result, stretch - stretch.transpose(), scale);
+                append(result, orthonormality(d.rotation), 1);
+
+                result.push_back(widen(d.rotation).determinant() - 1);
+
+                return result;
+            }
+
+            // ┌----------------------------------------------------┐
+            // │    geometry                                        |
+            // └----------------------------------------------------┘
+
+            GLA_NODISCARD inline obb<float> box(generator &g, float spread)
+            {
+                return obb<float>(g.vector<3>(input_class::uniform) * (spread / 8), g.rotation(), vec3(g.uniform(0.1F, 4), g.uniform(0.1F, 4), g.uniform(0.1F, 4)));
+            }
+
+            struct obb_input
+            {
+                obb<float> box;
+
+                // clear of 'box' along one of its axes, and around a point inside it
+                obb<float> separated;
+                obb<float> overlapping;
+
+                // candidate pairs of a cluster, some overlap and some do not
+                std::vector<obb<float>> cluster;
+                std::vector<std::uint32_t> pairs;
+            };
+
+            GLA_NODISCARD inline obb_input boxes(generator &g)
+            {
+                obb_input result;
+
+                result.box = box(g, 8);
+                result.separated = box(g, 8);
+                result.overlapping = box(g, 8);
+
+                const int k = static_cast<int>(g.engine() % 3);
+                const vec3 axis = result.box.axes[k] * g.sign();
+
+                // the radius of the other box along the axis
+                float radius = 0;
+
+                for (int i = 0; i < 3; i++) radius += std::abs(vec3::dot(axis, result.separated.axes[i])) * result.separated.extents[i];
+
+                result.separated.center = result.box.center + axis * (result.box.extents[k] + radius + g.uniform(0.05F, 1));
+
+                vec3 inside = result.box.center;
+
+                for (int i = 0; i < 3; i++) inside += result.box.axes[i] * (g.uniform(-0.9F, 0.9F) * result.box.extents[i]);
+
+                result.overlapping.center = inside;
+
+                result.cluster.resize(8);
+
+                for (obb<float> &b : result.cluster) b = box(g, 6);
+
+                for (std::uint32_t i = 0; i < 8; i++) for (std::uint32_t j = i + 1; j < 8; j++) result.pairs.insert(result.pairs.end(), { i, j });
+
+                return result;
+            }
+
+            // the overlapping candidates, padded with -1 to one entry per candidate
+            GLA_NODISCARD inline std::vector<double> padded(const std::vector<std::uint32_t> &hits, std::size_t count)
+            {
+                std::vector<double> result(hits.begin(), hits.end());
+
+                result.resize(count, -1);
+
+                return result;
+            }
+
+            struct hilbert_input
+            {
+                uivec2 cell2;
+                uivec3 cell3;
+
+                unsigned int bits2;
+                unsigned int bits3;
+            };
+
+            // a cell of a grid of 'bits' bits per axis, neither the first nor the last one along the curve
+            GLA_NODISCARD inline hilbert_input hilbert_cells(generator &g)
+            {
+                hilbert_input result;
+
+                result.bits2 = 1 + static_cast<unsigned int>(g.engine() % 32);
+                result.bits3 = 1 + static_cast<unsigned int>(g.engine() % 21);
+
+                const std::uint64_t last2 = (result.bits2 == 32) ? ~std::uint64_t(0) : (std::uint64_t(1) << (2 * result.bits2)) - 1;
+                const std::uint64_t last3 = (std::uint64_t(1) << (3 * result.bits3)) - 1;
+
+                const std::uint64_t mask2 = (std::uint64_t(1) << result.bits2) - 1;
+                const std::uint64_t mask3 = (std::uint64_t(1) << result.bits3) - 1;
+
+                do
+                {
+                    result.cell2 = uivec2(static_cast<unsigned int>(g.engine() & mask2), static_cast<unsigned int>(g.engine() & mask2));
+                }
+                while (hilbert_key(result.cell2, result.bits2) == 0 || hilbert_key(result.cell2, result.bits2) == last2);
+
+                do
+                {
+                    result.cell3 = uivec3(static_cast<unsigned int>(g.engine() & mask3), static_cast<unsigned int>(g.engine() & mask3),
+                                          static_cast<unsigned int>(g.engine() & mask3));
+                }
+                while (hilbert_key(result.cell3, result.bits3) == 0 || hilbert_key(result.cell3, result.bits3) == last3);
+
+                return result;
+            }
+
+            // how many of the cell's neighbours are next to it along the curve, two when the curve is continuous
+            template<std::size_t D>
+            GLA_NODISCARD static double curve_neighbours(const vec<D, unsigned int> &cell, unsigned int bits)
+            {
+                const std::uint64_t key = hilbert_key(cell, bits);
+                const unsigned int highest = static_cast<unsigned int>((std::uint64_t(1) << bits) - 1);
+
+                double result = 0;
+
+                for (std::size_t i = 0; i < D; i++)
+                {
+                    for (int step = -1; step <= 1; step += 2)
+                    {
+                        if ((step < 0 && cell[i] == 0) || (step > 0 && cell[i] == highest)) continue;
+
+                        vec<D, unsigned int> neighbour = cell;
+
+                        neighbour[i] += static_cast<unsigned int>(step);
+
+                        const std::uint64_t k = hilbert_key(neighbour, bits);
+
+                        result += (k == key + 1 || k + 1 == key) ? 1 : 0;
+                    }
+                }
+
+                return result;
+            }
+
+            // a 64 bit key as two doubles, which hold every uint32 exactly
+            GLA_NODISCARD inline std::vector<double> halves(std::uint64_t key)
+            {
+                return { static_cast<double>(key >> 32), static_cast<double>(key & 0xFFFFFFFFU) };
+            }
+
+            // bit i of every axis goes to bit (i * D + axis)
+            template<std::size_t D>
+            GLA_NODISCARD static std::vector<double> interleave(const vec<D, unsigned int> &cell, unsigned int bits)
+            {
+                std::uint64_t key = 0;
+
+                for (unsigned int i = 0; i < bits; i++)
+                {
+                    for (std::size_t axis = 0; axis < D; axis++) key |= std::uint64_t((cell[axis] >> i) & 1) << (i * D + axis);
+                }
+
+                return halves(key);
+            }
+
+            // keys of a dozen random bits, so there are many equal ones, across more than one chunk of the parallel passes
+            GLA_NODISCARD inline std::vector<std::uint64_t> sort_keys(generator &g)
+            {
+                std::uint64_t mask = 0;
+
+                for (int i = 0; i < 12; i++) mask |= std::uint64_t(1) << (g.engine() % 64);
+
+                std::vector<std::uint64_t> result(1 + g.engine() % (gla::detail::SPACE_FILLING_GRAIN * 3 / 2));
+
+                for (std::uint64_t &key : result) key = g.engine() & mask;
+
+                return result;
+            }
+
+            // a mesh that tiles [ -1, 1 ]^2 exactly: a jittered grid, each cell split along a random diagonal. every triangle has
+            // its own vertices and is closer than the ones before it, so the depth test hides no second hit on a pixel
+            struct tiling_input
+            {
+                int width;
+                int height;
+
+                std::vector<vec3> positions;
+                std::vector<std::uint32_t> indices;
+            };
+
+            GLA_NODISCARD inline tiling_input tiling(generator &g)
+            {
+                tiling_input result;
+
+                result.width = 24 + static_cast<int>(g.engine() % 80);
+                result.height = 24 + static_cast<int>(g.engine() % 80);
+
+                const int nx = 2 + static_cast<int>(g.engine() % 7);
+                const int ny = 2 + static_cast<int>(g.engine() % 7);
+
+                // a tenth of a cell keeps every triangle counter-clockwise. vertices on half pixels put many edges exactly
+                // through pixel centres, where only the top-left rule decides
+                std::vector<vec2> grid((nx + 1) * (ny + 1));
+
+                for (int j = 0; j <= ny; j++)
+                {
+                    for (int i = 0; i <= nx; i++)
+                    {
+                        vec2 p(static_cast<float>(i) / nx, static_cast<float>(j) / ny);
+
+                        if (i != 0 && i != nx) p.x += g.uniform(-0.1F, 0.1F) / nx;
+                        if (j != 0 && j != ny) p.y += g.uniform(-0.1F, 0.1F) / ny;
+
+                        p.x = std::round(p.x * result.width * 2) / (result.width * 2);
+                        p.y = std::round(p.y * result.height * 2) / (result.height * 2);
+
+                        grid[j * (nx + 1) + i] = p * 2.0F - vec2(1);
+                    }
+                }
+
+                std::vector<vec2> corners;
+
+                for (int j = 0; j < ny; j++)
+                {
+                    for (int i = 0; i < nx; i++)
+                    {
+                        const vec2 &p00 = grid[j * (nx + 1) + i], &p10 = grid[j * (nx + 1) + i + 1];
+                        const vec2 &p01 = grid[(j + 1) * (nx + 1) + i], &p11 = grid[(j + 1) * (nx + 1) + i + 1];
+
+                        if (g.engine() & 1) corners.insert(corners.end(), { p00, p10, p11, p00, p11, p01 });
+                        else                corners.insert(corners.end(), { p00, p10, p01, p10, p11, p01 });
+                    }
+                }
+
+                const std::size_t triangles = corners.size() / 3;
+
+                for (std::size_t t = 0; t < triangles; t++)
+                {
+                    const float z = 0.9F - 1.8F * static_cast<float>(t + 1) / static_cast<float>(triangles + 1);
+
+                    for (int k = 0; k < 3; k++)
+                    {
+                        result.positions.push_back(vec3(corners[t * 3 + k].x, corners[t * 3 + k].y, z));
+                        result.indices.push_back(static_cast<std::uint32_t>(t * 3 + k));
+                    }
+                }
+
+                return result;
+            }
+
+            // how many times each pixel is shaded
+            GLA_NODISCARD inline std::vector<double> coverage(const tiling_input &input)
+            {
+                rasterizer r(input.width, input.height, 16);
+
+                r.cull = rasterizer::culling::none;
+
+                // each pixel belongs to one tile, and tiles are the unit of parallelism, so the counts do not race
+                std::vector<double> counts(static_cast<std::size_t>(input.width) * input.height, 0);
+
+                r.draw(mat4x4::identity(), input.positions.data(), input.positions.size(), input.indices.data(), input.indices.size() / 3,
+                       [&](const fragment &f) { counts[static_cast<std::size_t>(f.y) * input.width + f.x]++; return 0U; });
+
+                return counts;
+            }
+
+            // triangles with their own vertices, in front of the camera and mostly crossing the frustum
+            struct clip_input
+            {
+                std::vector<vec4> positions;
+                std::vector<std::uint32_t> codes;
+                std::vector<std::uint32_t> indices;
+            };
+
+            GLA_NODISCARD inline clip_input frustum_triangles(generator &g)
+            {
+                clip_input result;
+
+                for (std::uint32_t i = 0; i < 48; i++)
+                {
+                    const float w = g.uniform(0.5F, 2);
+
+                    result.positions.push_back(vec4(g.uniform(-2, 2) * w, g.uniform(-2, 2) * w, g.uniform(-2, 2) * w, w));
+                    result.indices.push_back(i);
+                }
+
+                result.codes.resize(result.positions.size());
+
+                outcodes(result.positions.data(), result.positions.size(), result.codes.data());
+
+                return result;
+            }
+
+            // how far each output vertex is outside the frustum over w, and how far it is from what its barycentrics
+            // say over the largest source coordinate
+            GLA_NODISCARD inline std::vector<double> clip_residuals(const clip_input &input)
+            {
+                const std::size_t count = input.indices.size() / 3;
+
+                std::vector<clipped_triangle> output(count * CLIP_MAX_TRIANGLES);
+
+                const clip_result clipped = gla::clip_triangles(input.positions.data(), input.codes.data(), input.indices.data(), count, output.data(), output.size());
+
+                std::vector<double> result;
+
+                for (std::size_t t = 0; t < clipped.written; t++)
+                {
+                    const clipped_triangle &c = output[t];
+
+                    const dvec4 source[3] = { widen(input.positions[input.indices[c.triangle * 3 + 0]]),
+                                              widen(input.positions[input.indices[c.triangle * 3 + 1]]),
+                                              widen(input.positions[input.indices[c.triangle * 3 + 2]]) };
+
+                    double scale = 0;
+
+                    for (const dvec4 &s : source) for (int i = 0; i < 4; i++) scale = std::max(scale, std::abs(s[i]));
+
+                    for (int k = 0; k < 3; k++)
+                    {
+                        const dvec4 p = widen(c.position[k]);
+
+                        for (int i = 0; i < 3; i++) result.push_back(std::max(0.0, std::abs(p[i]) - p.w) / p.w);
+
+                        const dvec4 expected = source[0] * c.barycentric[k].x + source[1] * c.barycentric[k].y + source[2] * c.barycentric[k].z;
+
+                        for (int i = 0; i < 4; i++) result.push_back((p[i] - expected[i]) / scale);
+                    }
+                }
+
+                result.push_back(static_cast<double>(count - clipped.consumed));
+
+                return result;
+            }
+
+            // every output triangle, flushed whenever 'capacity' fills up, as positions and source triangles
+            GLA_NODISCARD inline std::vector<double> clip_flushed(const clip_input &input, std::size_t capacity)
+            {
+                const std::size_t count = input.indices.size() / 3;
+
+                std::vector<clipped_triangle> output(capacity);
+
+                std::vector<double> result;
+
+                for (std::size_t first = 0; first < count; )
+                {
+                    const clip_result clipped = gla::clip_triangles(input.positions.data(), input.codes.data(), input.indices.data() + first * 3, count - first,
+                                                                    output.data(), capacity);
+
+                    for (std::size_t t = 0; t < clipped.written; t++)
+                    {
+                        for (const vec4 &p : output[t].position) result.insert(result.end(), { p.x, p.y, p.z, p.w });
+
+                        result.push_back(static_cast<double>(first + output[t].triangle));
+                    }
+
+                    first += clipped.consumed;
+                }
+
+                return result;
+            }
+
+            // a heightfield over a jittered grid, with uvs roughly following x and y
+            struct surface_input
+            {
+                std::vector<vec3> positions;
+                std::vector<vec2> uvs;
+                std::vector<std::uint32_t> indices;
+            };
+
+            GLA_NODISCARD inline surface_input surface(generator &g)
+            {
+                surface_input result;
+
+                const std::uint32_t n = 6;
+
+                for (std::uint32_t j = 0; j < n; j++)
+                {
+                    for (std::uint32_t i = 0; i < n; i++)
+                    {
+                        result.positions.push_back(vec3(i + g.uniform(-0.2F, 0.2F), j + g.uniform(-0.2F, 0.2F), g.uniform(-1, 1)));
+                        result.uvs.push_back(vec2(i + g.uniform(-0.1F, 0.1F), j + g.uniform(-0.1F, 0.1F)) / static_cast<float>(n));
+                    }
+                }
+
+                for (std::uint32_t j = 0; j + 1 < n; j++)
+                {
+                    for (std::uint32_t i = 0; i + 1 < n; i++)
+                    {
+                        const std::uint32_t v = j * n + i;
+
+                        result.indices.insert(result.indices.end(), { v, v + 1, v + n + 1, v, v + n + 1, v + n });
+                    }
+                }
+
+                return result;
+            }
+
+            // unit normals, unit tangents perpendicular to them, handedness of one
+            GLA_NODISCARD inline std::vector<double> frame_residuals(const surface_input &input)
+            {
+                const std::size_t count = input.positions.size();
+
+                std::vector<vec3> normals(count);
+                std::vector<vec4> tangents(count);
+
+                vertex_normals(input.positions.data(), count, input.indices.data(), input.indices.size() / 3, normals.data());
+                vertex_tangents(input.positions.data(), input.uvs.data(), normals.data(), count, input.indices.data(), input.indices.size() / 3, tangents.data());
+
+                std::vector<double> result;
+
+                for (std::size_t v = 0; v < count; v++)
+                {
+                    const dvec3 n = widen(normals[v]);
+                    const dvec3 t = dvec3(tangents[v].x, tangents[v].y, tangents[v].z);
+
+                    result.insert(result.end(), { n.length() - 1, t.length() - 1, dvec3::dot(n, t), std::abs(static_cast<double>(tangents[v].w)) - 1 });
+                }
+
+                return result;
+            }
+
+            // ┌----------------------------------------------------┐
+            // │    containers                                      |
+            // └----------------------------------------------------┘
+
+            // points inserted one by one and in a batch, some moved and some removed, then queried
+            struct hash_input
+            {
+                float cell_size;
+
+                std::vector<vec3> inserted;
+                std::vector<vec3> moved;
+                std::vector<bool> removed;
+
+                std::vector<vec3> queries;
+                float radius;
+            };
+
+            GLA_NODISCARD inline hash_input hash_points(generator &g)
+            {
+                hash_input result;
+
+                result.cell_size = g.uniform(0.5F, 3);
+                result.radius = g.uniform(0.5F, 4);
+
+                for (int i = 0; i < 200; i++)
+                {
+                    const vec3 p = g.vector<3>(input_class::uniform);
+
+                    result.inserted.push_back(p);
+                    result.moved.push_back((g.engine() % 3 == 0) ? g.vector<3>(input_class::uniform) : p);
+                    result.removed.push_back(g.engine() % 4 == 0);
+                }
+
+                for (int i = 0; i < 16; i++) result.queries.push_back(g.vector<3>(input_class::uniform));
+
+                return result;
+            }
+
+            // the points found by each query in ascending order, -1 after each, then the number of points left
+            GLA_NODISCARD inline std::vector<double> hash_found(const hash_input &input)
+            {
+                const std::size_t count = input.inserted.size();
+
+                // a small table, so it rehashes on the way
+                spatial_hash_grid<float> grid(input.cell_size, 16);
+
+                std::vector<spatial_hash_grid<float>::handle> handles(count);
+
+                for (std::size_t i = 0; i < count / 2; i++) handles[i] = grid.insert(input.inserted[i]);
+
+                grid.insert(input.inserted.data() + count / 2, count - count / 2, handles.data() + count / 2);
+
+                std::vector<double> point(count + 1);
+
+                for (std::size_t i = 0; i < count; i++)
+                {
+                    point[handles[i]] = static_cast<double>(i);
+
+                    if (input.moved[i] != input.inserted[i]) grid.move(handles[i], input.moved[i]);
+                }
+
+                for (std::size_t i = 0; i < count; i++) if (input.removed[i]) grid.remove(handles[i]);
+
+                std::vector<double> result;
+
+                for (const vec3 &center : input.queries)
+                {
+                    const std::size_t first = result.size();
+
+                    grid.query_radius(center, input.radius, [&](spatial_hash_grid<float>::handle h, const vec3 &) { result.push_back(point[h]); });
+
+                    std::sort(result.begin() + static_cast<std::ptrdiff_t>(first), result.end());
+
+                    result.push_back(-1);
+                }
+
+                result.push_back(static_cast<double>(grid.size()));
+
+                return result;
+            }
+
+            GLA_NODISCARD inline std::vector<double> brute_force_found(const hash_input &input)
+            {
+                std::vector<double> result;
+
+                std::size_t left = 0;
+
+                for (std::size_t i = 0; i < input.inserted.size(); i++) left += input.removed[i] ? 0 : 1;
+
+                for (const vec3 &center : input.queries)
+                {
+                    for (std::size_t i = 0; i < input.inserted.size(); i++)
+                    {
+                        if (!input.removed[i] && (input.moved[i] - center).squared_length() <= input.radius * input.radius) result.push_back(static_cast<double>(i));
+                    }
+
+                    result.push_back(-1);
+                }
+
+                result.push_back(static_cast<double>(left));
+
+                return result;
+            }
+
+            // a few matrices used over and over, replaced now and then, which bumps their version
+            struct cache_step
+            {
+                // 0 inverse, 1 determinant, 2 multiply, 3 replace 'a' with 'replacement'
+                int operation;
+                bool stamped;
+
+                std::size_t a, b;
+
+                mat4x4 replacement;
+            };
+
+            struct cache_input
+            {
+                std::vector<mat4x4> matrices;
+                std::vector<cache_step> steps;
+            };
+
+            GLA_NODISCARD inline cache_input cache_steps(generator &g)
+            {
+                cache_input result;
+
+                for (int i = 0; i < 6; i++) result.matrices.push_back(g.matrix(input_class::uniform));
+
+                for (int i = 0; i < 64; i++)
+                {
+                    const int operation = (g.engine() % 8 == 0) ? 3 : static_cast<int>(g.engine() % 3);
+
+                    cache_step step { operation, (g.engine() & 1) != 0, g.engine() % 6, g.engine() % 6, mat4x4() };
+
+                    if (step.operation == 3) step.replacement = g.matrix(input_class::uniform);
+
+                    result.steps.push_back(step);
+                }
+
+                return result;
+            }
+
+            // every result of the steps, computed directly or through a cache too small to hold them all
+            GLA_NODISCARD inline std::vector<float> cache_results(const cache_input &input, bool cached)
+            {
+                transform_cache<float> cache(4);
+
+                std::vector<mat4x4> matrices = input.matrices;
+                std::vector<std::uint64_t> versions(matrices.size(), 0);
+
+                std::vector<float> result;
+
+                for (const cache_step &s : input.steps)
+                {
+                    const mat4x4 &a = matrices[s.a], &b = matrices[s.b];
+
+                    switch (s.operation)
+                    {
+                        case 0:
+                            append(result, !cached ? a.inverse() : s.stamped ? cache.inverse(s.a, versions[s.a], a) : cache.inverse(a));
+                            break;
+
+                        case 1:
+                            result.push_back(!cached ? a.determinant() : s.stamped ? cache.determinant(s.a, versions[s.a], a) : cache.determinant(a));
+                            break;
+
+                        case 2:
+                            append(result, !cached ? a * b : s.stamped ? cache.multiply(s.a, versions[s.a], a, s.b, versions[s.b], b) : cache.multiply(a, b));
+                            break;
+
+                        default:
+                            matrices[s.a] = s.replacement;
+                            versions[s.a]++;
+                    }
+                }
+
+                return result;
+            }
+        }
+
+        // a property instead of a reference: 'residuals(input)' returns what must be zero, each divided by the size of what
+        // it was computed from, so the error comes out in ulps of one, units of float epsilon. inputs are uniform
+        template<typename G, typename P>
+        static report holds(const std::string &name, std::size_t samples, double bound, std::uint64_t seed, G &&generate, P &&residuals)
+        {
+            report r;
+
+            r.name = name;
+            r.ulp_bound = bound;
+            r.scale_floors = { 1 };
+
+            generator g(seed);
+
+            for (std::size_t i = 0; i < samples; i++)
+            {
+                for (double residual : residuals(generate(g))) r.add(0.0, static_cast<float>(residual), 0.0);
+
+                r.next_sample();
+            }
+
+            return r;
+        }
+
+        // ┌----------------------------------------------------┐
+        // │    suite                                           |
+        // └----------------------------------------------------┘
+
+        // every kernel against its reference for every input class, prints one line per pair, true if all passed
+        inline bool run_all(std::ostream &out, std::size_t samples = 10000, std::uint64_t seed = 0x5EED)
+        {
+            std::vector<report> reports;
+
+            const input_class classes[] = { input_class::uniform, input_class::denormal, input_class::huge, input_class::degenerate };
+
+            for (input_class inputs : classes)
+            {
+                // float against double
+
+                reports.push_back(compare("mat4x4 * mat4x4", inputs, samples, 8, seed,
+                    [&](generator &g) { return std::make_pair(g.matrix(inputs, 2), g.matrix(inputs, 2)); },
+                    [](const std::pair<mat4x4, mat4x4> &m) { return detail::widen(m.first) * detail::widen(m.second); },
+                    [](const std::pair<mat4x4, mat4x4> &m) { return m.first * m.second; }));
+
+                // a near-singular input loses up to cond(m) ulps, around 1e7 for the degenerate class
+                reports.push_back(compare("mat4x4::inverse", inputs, samples, bounds(32, 1 << 30), seed,
+                    [&](generator &g)
+                    {
+                        // inverse() asserts on a zero determinant, so only invertible inputs are drawn
+                        mat4x4 m = g.matrix(inputs, 4);
+
+                        while (m.determinant() == 0) m = g.matrix(inputs, 4);
+
+                        return m;
+                    },
+                    [](const mat4x4 &m) { return detail::widen(m).inverse(); },
+                    [](const mat4x4 &m) { return m.inverse(); }));
+
+                // against the hadamard bound, so a determinant that cancels to nearly zero is measured against the size of its terms
+                reports.push_back(compare("mat4x4::determinant", inputs, samples, 16, seed,
+                    [&](generator &g) { return g.matrix(inputs, 4); },
+                    [](const mat4x4 &m) { return with_scale(detail::widen(m).determinant(), detail::hadamard(m)); },
+                    [](const mat4x4 &m) { return with_scale(m.determinant(), detail::hadamard(m)); }));
+
+                reports.push_back(compare("vec3::normalized", inputs, samples, 2, seed,
+                    [&](generator &g) { return g.vector<3>(inputs); },
+                    [](const vec3 &v) { return detail::widen(v).normalized(); },
+                    [](const vec3 &v) { return v.normalized(); }));
+
+                reports.push_back(compare("radians", inputs, samples, 1, seed,
+                    [&](generator &g) { return g.scalar(inputs) * 45; },
+                    [](float degrees) { return degrees * (3.14159265358979323846 / 180); },
+                    [](float degrees) { return radians(degrees); }));
+
+                reports.push_back(compare("cotan", inputs, samples, 4, seed,
+                    [&](generator &g) { return (inputs == input_class::degenerate) ? std::round(g.uniform(-4, 4)) * PI + g.scalar(inputs) : g.scalar(inputs); },
+                    [](float x) { return cotan(static_cast<double>(x)); },
+                    [](float x) { return cotan(x); }));
+
+                // storage layouts against the math types
+
+                reports.push_back(compare("row_major_mat * and store()", inputs, samples, 0, seed,
+                    [&](generator &g) { return std::make_pair(g.matrix(inputs, 2), g.matrix(inputs, 2)); },
+                    [](const std::pair<mat4x4, mat4x4> &m) { return m.first * m.second; },
+                    [](const std::pair<mat4x4, mat4x4> &m)
+                    {
+                        const row_major_mat<4, 4, float> product = row_major_mat<4, 4, float>(m.first) * row_major_mat<4, 4, float>(m.second);
+
+                        float rows[16];
+
+                        store(&product, 1, rows);
+
+                        mat4x4 result;
+
+                        for (int c = 0; c < 4; c++) for (int r = 0; r < 4; r++) result[c][r] = rows[r * 4 + c];
+
+                        return result;
+                    }));
+
+                // sse against scalar
+
+            #if GLA_SIMD_SSE2
+                // pixels against the window size, depth against its [ 0, 1 ] range, 1 / w against itself
+                reports.push_back(compare("clip_to_window (refined rcp)", inputs, samples, 8, seed,
+                    [&](generator &g)
+                    {
+                        // the kernel expects clipped vertices
+                        vec4 p = g.vector<4>(inputs);
+
+                        p.w = std::max(std::abs(p.w), FLT_MIN);
+
+                        for (int i = 0; i < 3; i++) p[i] = clamp(p[i], - p.w, p.w);
+
+                        return p;
+                    },
+                    [](const vec4 &p) { vec4 w; clip_to_window<float>(&p, 1, viewport<float>(0, 0, 1920, 1080), &w); return w; },
+                    [](const vec4 &p) { vec4 w; clip_to_window(&p, 1, viewport<float>(0, 0, 1920, 1080), &w, reciprocal::refined); return w; },
+                    { 1920, 1080, 1, 0 }));
+
+                reports.push_back(compare("skin_linear", inputs, samples, 4, seed,
+                    [&](generator &g)
+                    {
+                        std::pair<std::vector<mat4x4>, vec3> input { std::vector<mat4x4>(4), g.vector<3>(inputs, 2) };
+
+                        for (mat4x4 &joint : input.first) joint = g.matrix(inputs, 2);
+
+                        return input;
+                    },
+                    [](const std::pair<std::vector<mat4x4>, vec3> &input)
+                    {
+                        const uivec4 joints(0, 1, 2, 3);
+                        const vec4 weights(0.1F, 0.2F, 0.3F, 0.4F);
+
+                        vec3 result;
+
+                        skin_linear<float>(input.first.data(), &input.second, nullptr, &joints, &weights, 1, &result, nullptr);
+
+                        return result;
+                    },
+                    [](const std::pair<std::vector<mat4x4>, vec3> &input)
+                    {
+                        const uivec4 joints(0, 1, 2, 3);
+                        const vec4 weights(0.1F, 0.2F, 0.3F, 0.4F);
+
+                        vec3 result;
+
+                        skin_linear(input.first.data(), &input.second, nullptr, &joints, &weights, 1, &result, nullptr);
+
+                        return result;
+                    }));
+
+                // the translations cancel, so errors are measured against their size
+                reports.push_back(compare("skinning_palette", inputs, samples, 4, seed,
+                    [&](generator &g) { return std::make_pair(g.rigid(inputs), g.rigid(inputs)); },
+                    [](const std::pair<mat4x4, mat4x4> &input) { mat4x4 palette; skinning_palette<float>(&input.first, &input.second, 1, &palette); return with_scale(palette, detail::extent(input)); },
+                    [](const std::pair<mat4x4, mat4x4> &input) { mat4x4 palette; skinning_palette(&input.first, &input.second, 1, &palette); return with_scale(palette, detail::extent(input)); }));
+
+                // as for the palette, the translations cancel in the skinned positions
+                // blending four dual quaternions and normalizing the blend rounds more than a matrix palette does
+                reports.push_back(compare("skin_dual_quaternion", inputs, samples, 32, seed,
+                    [&](generator &g)
+                    {
+                        detail::skinning_input input;
+
+                        // the joints of one vertex turn alike, blending opposite rotations is ill-conditioned in any precision
+                        const mat4x4 pivot = g.rigid(inputs);
+
+                        for (dualquat &joint : input.palette)
+                        {
+                            const mat4x4 transform = pivot * g.rigid(inputs, 0.25F);
+
+                            joint = dualquat(transform);
+
+                            input.extent = std::max(input.extent, detail::extent(transform));
+                        }
+
+                        input.position = g.vector<3>(inputs);
+
+                        for (int k = 0; k < 3; k++) input.extent = std::max(input.extent, std::abs(static_cast<double>(input.position[k])));
+                        input.normal = vec3(g.uniform(-1, 1), g.uniform(-1, 1), 1).normalized();
+
+                        const vec4 weights(g.uniform(0, 1), g.uniform(0, 1), g.uniform(0, 1), g.uniform(0, 1));
+
+                        input.weights = weights / (weights.x + weights.y + weights.z + weights.w);
+
+                        return input;
+                    },
+                    [](const detail::skinning_input &input)
+                    {
+                        std::pair<vec3, vec3> result;
+
+                        skin_dual_quaternion<float>(input.palette, &input.position, &input.normal, &input.joints, &input.weights, 1, &result.first, &result.second);
+
+                        return with_scale(result, input.extent);
+                    },
+                    [](const detail::skinning_input &input)
+                    {
+                        std::pair<vec3, vec3> result;
+
+                        skin_dual_quaternion(input.palette, &input.position, &input.normal, &input.joints, &input.weights, 1, &result.first, &result.second);
+
+                        return with_scale(result, input.extent);
+                    }));
+
+                reports.push_back(compare("vec4 comparisons", inputs, samples, 0, seed,
+                    [&](generator &g)
+                    {
+                        std::pair<vec4, vec4> input { g.vector<4>(inputs), g.vector<4>(inputs) };
+
+                        // equal lanes for equal() and near()
+                        for (int i = 0; i < 4; i++) if (g.engine() & 1) input.second[i] = input.first[i];
+
+                        return input;
+                    },
+                    [](const std::pair<vec4, vec4> &input)
+                    {
+                        const vec4 &a = input.first, &b = input.second;
+
+                        const bvec4 masks[7] = { less<4, float>(a, b), less_equal<4, float>(a, b), greater<4, float>(a, b), greater_equal<4, float>(a, b),
+                                                 equal<4, float>(a, b), not_equal<4, float>(a, b), near<4, float>(a, b) };
+
+                        return detail::mask_bits(masks);
+                    },
+                    [](const std::pair<vec4, vec4> &input)
+                    {
+                        const vec4 &a = input.first, &b = input.second;
+
+                        const bvec4 masks[7] = { less(a, b), less_equal(a, b), greater(a, b), greater_equal(a, b), equal(a, b), not_equal(a, b), near(a, b) };
+
+                        return detail::mask_bits(masks);
+                    }));
+
+                reports.push_back(compare("select", inputs, samples, 0, seed,
+                    [&](generator &g)
+                    {
+                        const bvec4 mask((g.engine() & 1) != 0, (g.engine() & 1) != 0, (g.engine() & 1) != 0, (g.engine() & 1) != 0);
+
+                        return std::make_pair(mask, std::make_pair(g.vector<4>(inputs), g.vector<4>(inputs)));
+                    },
+                    [](const std::pair<bvec4, std::pair<vec4, vec4>> &input) { return select<4, float>(input.first, input.second.first, input.second.second); },
+                    [](const std::pair<bvec4, std::pair<vec4, vec4>> &input) { return select(input.first, input.second.first, input.second.second); }));
+
+                // the sse compression kernels do four vertices per step, eight per sample also run their scalar tail
+
+                reports.push_back(compare("octahedral_encode", inputs, samples, 0, seed,
+                    [&](generator &g) { return detail::unit_vectors(g, inputs); },
+                    [](const std::vector<vec3> &normals) { return detail::encode(normals, [](const vec3 *n, std::size_t count, std::uint32_t *codes) { octahedral_encode<float>(n, count, 16, codes); }); },
+                    [](const std::vector<vec3> &normals) { return detail::encode(normals, [](const vec3 *n, std::size_t count, std::uint32_t *codes) { octahedral_encode(n, count, 16, codes); }); }));
+
+                reports.push_back(compare("octahedral_decode", inputs, samples, 0, seed,
+                    [&](generator &g)
+                    {
+                        std::vector<std::uint32_t> codes(8);
+
+                        octahedral_encode<float>(detail::unit_vectors(g, inputs).data(), codes.size(), 16, codes.data());
+
+                        return codes;
+                    },
+                    [](const std::vector<std::uint32_t> &codes) { std::vector<vec3> normals(codes.size()); octahedral_decode<float>(codes.data(), codes.size(), 16, normals.data()); return detail::flatten(normals); },
+                    [](const std::vector<std::uint32_t> &codes) { std::vector<vec3> normals(codes.size()); octahedral_decode(codes.data(), codes.size(), 16, normals.data()); return detail::flatten(normals); }));
+
+                reports.push_back(compare("quantize_positions", inputs, samples, 0, seed,
+                    [&](generator &g) { return detail::positions(g, inputs); },
+                    [](const detail::position_input &input) { return detail::quantize(input, [&](std::uint32_t *cells) { quantize_positions<float>(input.positions.data(), input.positions.size(), input.lowest, input.highest, 24, cells); }); },
+                    [](const detail::position_input &input) { return detail::quantize(input, [&](std::uint32_t *cells) { quantize_positions(input.positions.data(), input.positions.size(), input.lowest, input.highest, 24, cells); }); }));
+
+                reports.push_back(compare("dequantize_positions", inputs, samples, 1, seed,
+                    [&](generator &g)
+                    {
+                        detail::position_input input = detail::positions(g, inputs);
+
+                        input.cells.resize(3 * input.positions.size());
+
+                        quantize_positions<float>(input.positions.data(), input.positions.size(), input.lowest, input.highest, 24, input.cells.data());
+
+                        return input;
+                    },
+                    [](const detail::position_input &input) { std::vector<vec3> p(input.positions.size()); dequantize_positions<float>(input.cells.data(), p.size(), input.lowest, input.highest, 24, p.data()); return detail::flatten(p); },
+                    [](const detail::position_input &input) { std::vector<vec3> p(input.positions.size()); dequantize_positions(input.cells.data(), p.size(), input.lowest, input.highest, 24, p.data()); return detail::flatten(p); }));
+
+                // seven particles, one sse block and a scalar tail
+
+                reports.push_back(compare("integrate_euler", inputs, samples, 4, seed,
+                    [&](generator &g) { return detail::particles(g, inputs); },
+                    [](const detail::particle_input &input)
+                    {
+                        return detail::integrate(input, [](const stream3<float> &p, const stream3<float> &v, const stream3<const float> &a, const float *damping, std::size_t count, const particle_step<float> &step)
+                        {
+                            gla::detail::euler_chunk<float>(p, v, a, damping, 0, count, step);
+                        });
+                    },
+                    [](const detail::particle_input &input)
+                    {
+                        return detail::integrate(input, [](const stream3<float> &p, const stream3<float> &v, const stream3<const float> &a, const float *damping, std::size_t count, const particle_step<float> &step)
+                        {
+                            gla::detail::euler_chunk(p, v, a, damping, 0, count, step);
+                        });
+                    }));
+
+                reports.push_back(compare("integrate_verlet", inputs, samples, 4, seed,
+                    [&](generator &g) { return detail::particles(g, inputs); },
+                    [](const detail::particle_input &input)
+                    {
+                        return detail::integrate(input, [](const stream3<float> &p, const stream3<float> &q, const stream3<const float> &a, const float *damping, std::size_t count, const particle_step<float> &step)
+                        {
+                            gla::detail::verlet_chunk<float>(p, q, a, damping, 0, count, step);
+                        });
+                    },
+                    [](const detail::particle_input &input)
+                    {
+                        return detail::integrate(input, [](const stream3<float> &p, const stream3<float> &q, const stream3<const float> &a, const float *damping, std::size_t count, const particle_step<float> &step)
+                        {
+                            gla::detail::verlet_chunk(p, q, a, damping, 0, count, step);
+                        });
+                    }));
+            #endif
+            }
+
+            // properties of the kernels without a reference in double, and batched kernels against their single versions.
+            // uniform inputs only, the heavier checks run on a fraction of the samples
+            const std::size_t some = std::max<std::size_t>(samples / 100, 1);
+            const std::size_t few = std::max<std::size_t>(samples / 1000, 1);
+
+            const input_class uniform = input_class::uniform;
+
+            reports.push_back(holds("solve_lu residual", samples, 8, seed,
+                [](generator &g) { return std::make_pair(g.matrix(input_class::uniform), g.vector<4>(input_class::uniform)); },
+                [](const std::pair<mat4x4, vec4> &s) { vec4 x; (void) solve_lu(s.first, s.second, x); return detail::solve_residuals(s.first, s.second, x); }));
+
+            reports.push_back(holds("solve_cholesky residual", samples, 8, seed,
+                [](generator &g) { return std::make_pair(detail::positive_definite(g), g.vector<4>(input_class::uniform)); },
+                [](const std::pair<mat4x4, vec4> &s) { vec4 x; (void) solve_cholesky(s.first, s.second, x); return detail::solve_residuals(s.first, s.second, x); }));
+
+            reports.push_back(compare("solve_lu arrays", uniform, some, 0, seed,
+                [](generator &g) { return detail::systems(g, solve_status::near_singular); },
+                [](const detail::system_batch &s) { return detail::expected_solutions(s, solve_status::near_singular, [](const mat4x4 &a, const vec4 &b, vec4 &x) { return solve_lu(a, b, x); }); },
+                [](const detail::system_batch &s)
+                {
+                    std::vector<vec4> x(s.a.size());
+                    std::vector<solve_status> status(s.a.size());
+
+                    solve_lu(s.a.data(), s.b.data(), s.a.size(), x.data(), status.data());
+
+                    return detail::solutions(x, status);
+                }));
+
+            reports.push_back(compare("solve_lu soa", uniform, some, 0, seed,
+                [](generator &g) { return detail::systems(g, solve_status::near_singular); },
+                [](const detail::system_batch &s) { return detail::expected_solutions(s, solve_status::near_singular, [](const mat4x4 &a, const vec4 &b, vec4 &x) { return solve_lu(a, b, x); }); },
+                [](const detail::system_batch &s)
+                {
+                    return detail::soa_solutions(s, [](const float *const *a, const float *const *b, std::size_t count, float *const *x, solve_status *status)
+                    {
+                        solve_lu<4>(a, b, count, x, status);
+                    });
+                }));
+
+            reports.push_back(compare("solve_cholesky arrays", uniform, some, 0, seed,
+                [](generator &g) { return detail::systems(g, solve_status::not_positive_definite); },
+                [](const detail::system_batch &s) { return detail::expected_solutions(s, solve_status::not_positive_definite, [](const mat4x4 &a, const vec4 &b, vec4 &x) { return solve_cholesky(a, b, x); }); },
+                [](const detail::system_batch &s)
+                {
+                    std::vector<vec4> x(s.a.size());
+                    std::vector<solve_status> status(s.a.size());
+
+                    solve_cholesky(s.a.data(), s.b.data(), s.a.size(), x.data(), status.data());
+
+                    return detail::solutions(x, status);
+                }));
+
+            reports.push_back(compare("solve_cholesky soa", uniform, some, 0, seed,
+                [](generator &g) { return detail::systems(g, solve_status::not_positive_definite); },
+                [](const detail::system_batch &s) { return detail::expected_solutions(s, solve_status::not_positive_definite, [](const mat4x4 &a, const vec4 &b, vec4 &x) { return solve_cholesky(a, b, x); }); },
+                [](const detail::system_batch &s)
+                {
+                    return detail::soa_solutions(s, [](const float *const *a, const float *const *b, std::size_t count, float *const *x, solve_status *status)
+                    {
+                        solve_cholesky<4>(a, b, count, x, status);
+                    });
+                }));
+
+            // decompositions: reconstruction, orthonormal and proper factors, the promised order
+
+            reports.push_back(holds("eigen_symmetric", samples, 32, seed, detail::symmetric, detail::eigen_residuals));
+
+            reports.push_back(holds("svd", samples, 32, seed, detail::general, detail::svd_residuals));
+
+            reports.push_back(holds("polar", samples, 32, seed, detail::general, detail::polar_residuals));
+
+            // the sse sweeps against the scalar ones, exact with -ffp-contract=off as above
+
+            reports.push_back(compare("eigen_symmetric batched", uniform, some, 0, seed,
+                [](generator &g) { return detail::matrices(g, detail::symmetric); },
+                [](const std::vector<mat3x3> &m) { std::vector<symmetric_eigen<float>> e; for (const mat3x3 &x : m) e.push_back(eigen_symmetric(x)); return detail::flatten(e); },
+                [](const std::vector<mat3x3> &m) { std::vector<symmetric_eigen<float>> e(m.size()); eigen_symmetric(m.data(), m.size(), e.data()); return detail::flatten(e); }));
+
+            reports.push_back(compare("svd batched", uniform, some, 0, seed,
+                [](generator &g) { return detail::matrices(g, detail::general); },
+                [](const std::vector<mat3x3> &m) { std::vector<singular_value_decomposition<float>> d; for (const mat3x3 &x : m) d.push_back(svd(x)); return detail::flatten(d); },
+                [](const std::vector<mat3x3> &m) { std::vector<singular_value_decomposition<float>> d(m.size()); svd(m.data(), m.size(), d.data()); return detail::flatten(d); }));
+
+            reports.push_back(compare("polar batched", uniform, some, 0, seed,
+                [](generator &g) { return detail::matrices(g, detail::general); },
+                [](const std::vector<mat3x3> &m) { std::vector<polar_decomposition<float>> d; for (const mat3x3 &x : m) d.push_back(polar(x)); return detail::flatten(d); },
+                [](const std::vector<mat3x3> &m) { std::vector<polar_decomposition<float>> d(m.size()); polar(m.data(), m.size(), d.data()); return detail::flatten(d); }));
+
+            // geometry: boxes placed apart or into each other, then the batched test against the single one
+
+            reports.push_back(compare("obb overlap", uniform, samples, 0, seed, detail::boxes,
+                [](const detail::obb_input &input)
+                {
+                    std::vector<std::uint32_t> hits;
+
+                    for (std::size_t i = 0; i < input.pairs.size() / 2; i++)
+                    {
+                        if (overlap(input.cluster[input.pairs[2 * i]], input.cluster[input.pairs[2 * i + 1]])) hits.push_back(static_cast<std::uint32_t>(i));
+                    }
+
+                    std::vector<double> result = { 0, 0, 1, 1 };
+
+                    const std::vector<double> candidates = detail::padded(hits, input.pairs.size() / 2);
+
+                    result.insert(result.end(), candidates.begin(), candidates.end());
+
+                    return result;
+                },
+                [](const detail::obb_input &input)
+                {
+                    const std::size_t count = input.pairs.size() / 2;
+
+                    std::vector<std::uint32_t> hits(count);
+
+                    hits.resize(overlap(input.cluster.data(), input.pairs.data(), count, hits.data()));
+
+                    std::vector<double> result = { static_cast<double>(overlap(input.box, input.separated)), static_cast<double>(overlap(input.separated, input.box)),
+                                                   static_cast<double>(overlap(input.box, input.overlapping)), static_cast<double>(overlap(input.overlapping, input.box)) };
+
+                    const std::vector<double> candidates = detail::padded(hits, count);
+
+                    result.insert(result.end(), candidates.begin(), candidates.end());
+
+                    return result;
+                }));
+
+            reports.push_back(compare("morton_key", uniform, samples, 0, seed,
+                [](generator &g)
+                {
+                    return std::make_pair(uivec2(static_cast<unsigned int>(g.engine()), static_cast<unsigned int>(g.engine())),
+                                          uivec3(static_cast<unsigned int>(g.engine() & 0x1FFFFF), static_cast<unsigned int>(g.engine() & 0x1FFFFF), static_cast<unsigned int>(g.engine() & 0x1FFFFF)));
+                },
+                [](const std::pair<uivec2, uivec3> &cell)
+                {
+                    std::vector<double> result = detail::interleave(cell.first, 32), keys3 = detail::interleave(cell.second, 21);
+
+                    result.insert(result.end(), keys3.begin(), keys3.end());
+
+                    return result;
+                },
+                [](const std::pair<uivec2, uivec3> &cell)
+                {
+                    std::vector<double> result = detail::halves(morton_key(cell.first)), keys3 = detail::halves(morton_key(cell.second));
+
+                    result.insert(result.end(), keys3.begin(), keys3.end());
+
+                    return result;
+                }));
+
+            // consecutive keys are neighbouring cells: every cell but the ends has two neighbours next to it along the curve
+            reports.push_back(compare("hilbert_key adjacency", uniform, samples, 0, seed, detail::hilbert_cells,
+                [](const detail::hilbert_input &) { return std::vector<double> { 2, 2 }; },
+                [](const detail::hilbert_input &input) { return std::vector<double> { detail::curve_neighbours(input.cell2, input.bits2), detail::curve_neighbours(input.cell3, input.bits3) }; }));
+
+            // the permutation of a stable sort, then how many keys reorder() puts elsewhere than radix_sort()
+            reports.push_back(compare("radix_sort and reorder", uniform, few, 0, seed, detail::sort_keys,
+                [](const std::vector<std::uint64_t> &keys)
+                {
+                    std::vector<std::uint32_t> permutation(keys.size());
+
+                    for (std::size_t i = 0; i < keys.size(); i++) permutation[i] = static_cast<std::uint32_t>(i);
+
+                    std::stable_sort(permutation.begin(), permutation.end(), [&](std::uint32_t a, std::uint32_t b) { return keys[a] < keys[b]; });
+
+                    std::vector<double> result(permutation.begin(), permutation.end());
+
+                    result.push_back(0);
+
+                    return result;
+                },
+                [](const std::vector<std::uint64_t> &keys)
+                {
+                    std::vector<std::uint64_t> sorted = keys, reordered(keys.size());
+                    std::vector<std::uint32_t> permutation(keys.size());
+
+                    radix_sort(sorted.data(), sorted.size(), permutation.data());
+
+                    reorder(keys.data(), keys.size(), permutation.data(), reordered.data());
+
+                    std::vector<double> result(permutation.begin(), permutation.end());
+
+                    result.push_back(static_cast<double>(keys.size() - static_cast<std::size_t>(std::mismatch(sorted.begin(), sorted.end(), reordered.begin()).first - sorted.begin())));
+
+                    return result;
+                }));
+
+            // a mesh that tiles the screen shades every pixel exactly once
+            reports.push_back(compare("rasterizer coverage", uniform, some, 0, seed, detail::tiling,
+                [](const detail::tiling_input &input) { return std::vector<double>(static_cast<std::size_t>(input.width) * input.height, 1); },
+                detail::coverage));
+
+            reports.push_back(holds("clip_triangles", some, 8, seed, detail::frustum_triangles, detail::clip_residuals));
+
+            // flushing a full output and going on gives what one large enough output gets
+            reports.push_back(compare("clip_triangles flushed", uniform, some, 0, seed, detail::frustum_triangles,
+                [](const detail::clip_input &input) { return detail::clip_flushed(input, CLIP_MAX_TRIANGLES * input.indices.size() / 3); },
+                [](const detail::clip_input &input) { return detail::clip_flushed(input, CLIP_MAX_TRIANGLES); }));
+
+            reports.push_back(holds("vertex tangent frames", some, 8, seed, detail::surface, detail::frame_residuals));
+
+            // containers against brute force and direct computation
+
+            reports.push_back(compare("spatial_hash_grid", uniform, some, 0, seed, detail::hash_points, detail::brute_force_found, detail::hash_found));
+
+            reports.push_back(compare("transform_cache", uniform, some, 0, seed, detail::cache_steps,
+                [](const detail::cache_input &input) { return detail::cache_results(input, false); },
+                [](const detail::cache_input &input) { return detail::cache_results(input, true); }));
+
+            bool passed = true;
+
+            for (const report &r : reports)
+            {
+                out << r << std::endl;
+
+                passed &= r.passed();
+            }
+
+            return passed;
+        }
+    }
+}
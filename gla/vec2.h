@@ -108,7 +108,18 @@ namespace gla
         {
             GLA_STATIC_ASSERT(std::is_floating_point<T>::value, "function 'normalized()' only accepts floating-point value inputs!");
 
-            return (*this != zero()) ? (*this / length()) : zero();
+            GLA_INSTRUMENT_COUNT(normalized, vec2, T);
+
+            const T squared = squared_length();
+
+            if (squared >= std::numeric_limits<T>::min() && squared <= std::numeric_limits<T>::max()) return *this / std::sqrt(squared);
+
+            if (*this == zero()) return zero();
+
+            // the square under- or overflowed, a very short or very long vector is scaled by its largest component first
+            const vec scaled = *this / std::max(std::abs(x), std::abs(y));
+
+            return scaled / scaled.length();
         }
 
         GLA_NODISCARD static GLA_CONSTEXPR vec zero()
@@ -0,0 +1,208 @@
+#pragma once
+
+#include <cstring>
+
+#include "gla.h"
+#include "simd.h"
+
+/*
+    ┌--------------------------------------------------------------------------┐
+    |                                                                          |
+    | component-wise comparisons, producing a bvec mask per lane:              |
+    |                                                                          |
+    |   less, less_equal, greater, greater_equal, equal, not_equal, near       |
+    |                                                                          |
+    | masks reduce with any / all / none, and select(mask, a, b) picks 'a'     |
+    | where the mask is set and 'b' elsewhere, without branching.              |
+    |                                                                          |
+    | vec4 has sse overloads built on the native compare and blend             |
+    | (and / andnot / or) instructions.                                        |
+    |                                                                          |
+    └--------------------------------------------------------------------------┘
+*/
+
+namespace gla
+{
+    // ┌----------------------------------------------------┐
+    // │    comparisons                                     |
+    // └----------------------------------------------------┘
+
+    template<std::size_t D, typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR vec<D, bool> less(const vec<D, T> &a, const vec<D, T> &b)
+    {
+        vec<D, bool> result;
+
+        for (std::size_t i = 0; i < D; i++) result[i] = a[i] < b[i];
+
+        return result;
+    }
+
+    template<std::size_t D, typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR vec<D, bool> less_equal(const vec<D, T> &a, const vec<D, T> &b)
+    {
+        vec<D, bool> result;
+
+        for (std::size_t i = 0; i < D; i++) result[i] = a[i] <= b[i];
+
+        return result;
+    }
+
+    template<std::size_t D, typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR vec<D, bool> greater(const vec<D, T> &a, const vec<D, T> &b)
+    {
+        vec<D, bool> result;
+
+        for (std::size_t i = 0; i < D; i++) result[i] = a[i] > b[i];
+
+        return result;
+    }
+
+    template<std::size_t D, typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR vec<D, bool> greater_equal(const vec<D, T> &a, const vec<D, T> &b)
+    {
+        vec<D, bool> result;
+
+        for (std::size_t i = 0; i < D; i++) result[i] = a[i] >= b[i];
+
+        return result;
+    }
+
+    template<std::size_t D, typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR vec<D, bool> equal(const vec<D, T> &a, const vec<D, T> &b)
+    {
+        vec<D, bool> result;
+
+        for (std::size_t i = 0; i < D; i++) result[i] = a[i] == b[i];
+
+        return result;
+    }
+
+    template<std::size_t D, typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR vec<D, bool> not_equal(const vec<D, T> &a, const vec<D, T> &b)
+    {
+        vec<D, bool> result;
+
+        for (std::size_t i = 0; i < D; i++) result[i] = a[i] != b[i];
+
+        return result;
+    }
+
+    // | a - b | <= epsilon, per lane
+    template<std::size_t D, typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR vec<D, bool> near(const vec<D, T> &a, const vec<D, T> &b, T epsilon = static_cast<T>(EPSILON))
+    {
+        vec<D, bool> result;
+
+        for (std::size_t i = 0; i < D; i++) result[i] = std::abs(a[i] - b[i]) <= epsilon;
+
+        return result;
+    }
+
+    // ┌----------------------------------------------------┐
+    // │    reductions                                      |
+    // └----------------------------------------------------┘
+
+    template<std::size_t D>
+    GLA_NODISCARD static GLA_CONSTEXPR bool any(const vec<D, bool> &mask)
+    {
+        bool result = false;
+
+        for (std::size_t i = 0; i < D; i++) result |= mask[i];
+
+        return result;
+    }
+
+    template<std::size_t D>
+    GLA_NODISCARD static GLA_CONSTEXPR bool all(const vec<D, bool> &mask)
+    {
+        bool result = true;
+
+        for (std::size_t i = 0; i < D; i++) result &= mask[i];
+
+        return result;
+    }
+
+    template<std::size_t D>
+    GLA_NODISCARD static GLA_CONSTEXPR bool none(const vec<D, bool> &mask)
+    {
+        return !any(mask);
+    }
+
+    // ┌----------------------------------------------------┐
+    // │    selection                                       |
+    // └----------------------------------------------------┘
+
+    template<std::size_t D, typename T>
+    GLA_NODISCARD static GLA_CONSTEXPR vec<D, T> select(const vec<D, bool> &mask, const vec<D, T> &a, const vec<D, T> &b)
+    {
+        vec<D, T> result;
+
+        for (std::size_t i = 0; i < D; i++) result[i] = mask[i] ? a[i] : b[i];
+
+        return result;
+    }
+
+    // ┌----------------------------------------------------┐
+    // │    sse overloads                                   |
+    // └----------------------------------------------------┘
+
+#if GLA_SIMD_SSE2
+
+    GLA_STATIC_ASSERT(sizeof(bvec4) == 4, "bvec4 must be four bytes to be converted to and from a lane mask!");
+
+    namespace simd
+    {
+        // one bool per set bit of a movemask
+        inline bvec4 to_bvec(int bits)
+        {
+            return { (bits & 1) != 0, (bits & 2) != 0, (bits & 4) != 0, (bits & 8) != 0 };
+        }
+
+        // all-ones lanes where the bvec4 is set
+        inline __m128 to_mask(const bvec4 &mask)
+        {
+            int bytes;
+
+            std::memcpy(&bytes, &mask, sizeof(bytes));
+
+            // widen the four bytes to four 32-bit lanes
+            __m128i lanes = _mm_cvtsi32_si128(bytes);
+
+            lanes = _mm_unpacklo_epi8(lanes, lanes);
+            lanes = _mm_unpacklo_epi16(lanes, lanes);
+
+            return _mm_castsi128_ps(_mm_cmpgt_epi32(_mm_and_si128(lanes, _mm_set1_epi32(0xFF)), _mm_setzero_si128()));
+        }
+
+        // 'a' where 'mask' is set, 'b' elsewhere
+        inline __m128 blend(__m128 mask, __m128 a, __m128 b)
+        {
+            return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+        }
+    }
+
+    inline bvec4 less(const vec4 &a, const vec4 &b)             { return simd::to_bvec(_mm_movemask_ps(_mm_cmplt_ps(simd::load(a), simd::load(b)))); }
+    inline bvec4 less_equal(const vec4 &a, const vec4 &b)       { return simd::to_bvec(_mm_movemask_ps(_mm_cmple_ps(simd::load(a), simd::load(b)))); }
+    inline bvec4 greater(const vec4 &a, const vec4 &b)          { return simd::to_bvec(_mm_movemask_ps(_mm_cmpgt_ps(simd::load(a), simd::load(b)))); }
+    inline bvec4 greater_equal(const vec4 &a, const vec4 &b)    { return simd::to_bvec(_mm_movemask_ps(_mm_cmpge_ps(simd::load(a), simd::load(b)))); }
+    inline bvec4 equal(const vec4 &a, const vec4 &b)            { return simd::to_bvec(_mm_movemask_ps(_mm_cmpeq_ps(simd::load(a), simd::load(b)))); }
+    inline bvec4 not_equal(const vec4 &a, const vec4 &b)        { return simd::to_bvec(_mm_movemask_ps(_mm_cmpneq_ps(simd::load(a), simd::load(b)))); }
+
+    inline bvec4 near(const vec4 &a, const vec4 &b, float epsilon = EPSILON)
+    {
+        const __m128 difference = _mm_andnot_ps(_mm_set1_ps(-0.0F), _mm_sub_ps(simd::load(a), simd::load(b)));
+
+        return simd::to_bvec(_mm_movemask_ps(_mm_cmple_ps(difference, _mm_set1_ps(epsilon))));
+    }
+
+    inline vec4 select(const bvec4 &mask, const vec4 &a, const vec4 &b)
+    {
+        vec4 result;
+
+        simd::store(result, simd::blend(simd::to_mask(mask), simd::load(a), simd::load(b)));
+
+        return result;
+    }
+
+#endif
+}
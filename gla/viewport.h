@@ -0,0 +1,256 @@
+#pragma once
+
+#include "gla.h"
+#include "simd.h"
+
+/*
+    ┌--------------------------------------------------------------------------┐
+    |                                                                          |
+    | batched clip space to window space transform:                            |
+    |                                                                          |
+    |        ndc    = clip.xyz / clip.w                                        |
+    |                                                                          |
+    |        window = [ x + (ndc.x + 1) * width / 2,                           |
+    |                   y + (ndc.y + 1) * height / 2,                          |
+    |                   near + (ndc.z + 1) * (far - near) / 2,                 |
+    |                   1 / clip.w ]                                           |
+    |                                                                          |
+    | the fourth component keeps 1 / w for perspective-correct interpolation.  |
+    | y grows upwards like in opengl, a viewport with a negative height        |
+    | ( y = height, height = -height ) puts the origin at the top-left.        |
+    |                                                                          |
+    | vertices must be clipped to w > 0 first (see clipping.h).                |
+    |                                                                          |
+    | the sse path divides by reciprocal:                                      |
+    |                                                                          |
+    |   exact          1 / w, a full division                                  |
+    |   approximate    rcpps, about 12 bits                                    |
+    |   refined        rcpps and one newton-raphson step, about 22 bits        |
+    |                                                                          |
+    | the scalar path always divides exactly.                                  |
+    |                                                                          |
+    | window_fixed holds x and y in signed 16.8 fixed point (1/256 of a        |
+    | pixel, rounded to nearest even), saturated to +-32768 pixels.            |
+    |                                                                          |
+    └--------------------------------------------------------------------------┘
+*/
+
+namespace gla
+{
+    enum class reciprocal
+    {
+        exact,
+        approximate,
+        refined
+    };
+
+    template<typename T>
+    struct viewport
+    {
+        T x = 0;
+        T y = 0;
+        T width = 1;
+        T height = 1;
+
+        // depth range
+        T near = 0;
+        T far = 1;
+
+        viewport() = default;
+
+        viewport(T x, T y, T width, T height, T near = 0, T far = 1)
+            : x(x), y(y), width(width), height(height), near(near), far(far)
+        {
+
+        }
+    };
+
+    struct window_fixed
+    {
+        // 16.8 fixed point
+        std::int32_t x;
+        std::int32_t y;
+
+        float z;
+        float inverse_w;
+    };
+
+    // ┌----------------------------------------------------┐
+    // │    scalar kernels                                  |
+    // └----------------------------------------------------┘
+
+    namespace detail
+    {
+        // 16.8 fixed point, saturated to what 24 bits hold
+        GLA_NODISCARD inline std::int32_t to_fixed_16_8(float v)
+        {
+            return static_cast<std::int32_t>(std::nearbyint(clamp(v * 256.0F, -8388608.0F, 8388607.0F)));
+        }
+    }
+
+    template<typename T>
+    static void clip_to_window(const vec<4, T> *clip, std::size_t count, const viewport<T> &view, vec<4, T> *window, reciprocal division = reciprocal::refined)
+    {
+        GLA_INSTRUMENT_KERNEL("clip_to_window", count);
+
+        static_cast<void>(division);
+
+        const T scale_x = view.width / 2;
+        const T scale_y = view.height / 2;
+        const T scale_z = (view.far - view.near) / 2;
+
+        const T offset_x = view.x + scale_x;
+        const T offset_y = view.y + scale_y;
+        const T offset_z = view.near + scale_z;
+
+        for (std::size_t i = 0; i < count; i++)
+        {
+            const vec<4, T> &p = clip[i];
+
+            const T inverse_w = 1 / p.w;
+
+            window[i] = vec<4, T>(p.x * inverse_w * scale_x + offset_x, p.y * inverse_w * scale_y + offset_y, p.z * inverse_w * scale_z + offset_z, inverse_w);
+        }
+    }
+
+#if GLA_SIMD_SSE2
+
+    // ┌----------------------------------------------------┐
+    // │    sse kernels                                     |
+    // └----------------------------------------------------┘
+
+    namespace detail
+    {
+        inline __m128 inverse_of(__m128 w, gla::reciprocal division)
+        {
+            if (division == gla::reciprocal::exact) return _mm_div_ps(_mm_set1_ps(1.0F), w);
+
+            const __m128 r = _mm_rcp_ps(w);
+
+            if (division == gla::reciprocal::approximate) return r;
+
+            // r * (2 - w * r)
+            return _mm_mul_ps(r, _mm_sub_ps(_mm_set1_ps(2.0F), _mm_mul_ps(w, r)));
+        }
+
+        // four vertices, transposed to x, y, z and 1 / w registers
+        struct window_block
+        {
+            __m128 x, y, z, inverse_w;
+
+            window_block(const vec4 *clip, const viewport<float> &view, gla::reciprocal division)
+            {
+                __m128 w;
+
+                x = simd::load(clip[0]);
+                y = simd::load(clip[1]);
+                z = simd::load(clip[2]);
+                w = simd::load(clip[3]);
+
+                _MM_TRANSPOSE4_PS(x, y, z, w);
+
+                inverse_w = inverse_of(w, division);
+
+                const float scale_x = view.width / 2;
+                const float scale_y = view.height / 2;
+                const float scale_z = (view.far - view.near) / 2;
+
+                x = simd::madd(_mm_mul_ps(x, inverse_w), _mm_set1_ps(scale_x), _mm_set1_ps(view.x + scale_x));
+                y = simd::madd(_mm_mul_ps(y, inverse_w), _mm_set1_ps(scale_y), _mm_set1_ps(view.y + scale_y));
+                z = simd::madd(_mm_mul_ps(z, inverse_w), _mm_set1_ps(scale_z), _mm_set1_ps(view.near + scale_z));
+            }
+        };
+
+        // the last partial block goes through a padded copy
+        template<typename O, typename F>
+        inline void window_blocks(const vec4 *clip, std::size_t count, O *output, F &&block)
+        {
+            std::size_t i = 0;
+
+            for (; i + 4 <= count; i += 4) block(clip + i, output + i);
+
+            if (i == count) return;
+
+            vec4 padded[4] = { vec4(0, 0, 0, 1), vec4(0, 0, 0, 1), vec4(0, 0, 0, 1), vec4(0, 0, 0, 1) };
+            O rest[4];
+
+            std::copy(clip + i, clip + count, padded);
+
+            block(padded, rest);
+
+            std::copy(rest, rest + (count - i), output + i);
+        }
+    }
+
+    inline void clip_to_window(const vec4 *clip, std::size_t count, const viewport<float> &view, vec4 *window, reciprocal division = reciprocal::refined)
+    {
+        GLA_INSTRUMENT_KERNEL("clip_to_window", count);
+
+        detail::window_blocks(clip, count, window, [&](const vec4 *input, vec4 *output)
+        {
+            detail::window_block b(input, view, division);
+
+            _MM_TRANSPOSE4_PS(b.x, b.y, b.z, b.inverse_w);
+
+            simd::store(output[0], b.x);
+            simd::store(output[1], b.y);
+            simd::store(output[2], b.z);
+            simd::store(output[3], b.inverse_w);
+        });
+    }
+
+    // x and y in 16.8 fixed point
+    inline void clip_to_window(const vec4 *clip, std::size_t count, const viewport<float> &view, window_fixed *window, reciprocal division = reciprocal::refined)
+    {
+        GLA_STATIC_ASSERT(sizeof(window_fixed) == 4 * sizeof(float), "window_fixed must be tightly packed to be stored as a single register!");
+
+        GLA_INSTRUMENT_KERNEL("clip_to_window", count);
+
+        detail::window_blocks(clip, count, window, [&](const vec4 *input, window_fixed *output)
+        {
+            detail::window_block b(input, view, division);
+
+            const __m128 scale = _mm_set1_ps(256.0F);
+            const __m128 lowest = _mm_set1_ps(-8388608.0F);
+            const __m128 highest = _mm_set1_ps(8388607.0F);
+
+            // the integer bits ride in float registers through the transpose
+            __m128 x = _mm_castsi128_ps(_mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(b.x, scale), lowest), highest)));
+            __m128 y = _mm_castsi128_ps(_mm_cvtps_epi32(_mm_min_ps(_mm_max_ps(_mm_mul_ps(b.y, scale), lowest), highest)));
+
+            _MM_TRANSPOSE4_PS(x, y, b.z, b.inverse_w);
+
+            _mm_storeu_ps(reinterpret_cast<float *>(output + 0), x);
+            _mm_storeu_ps(reinterpret_cast<float *>(output + 1), y);
+            _mm_storeu_ps(reinterpret_cast<float *>(output + 2), b.z);
+            _mm_storeu_ps(reinterpret_cast<float *>(output + 3), b.inverse_w);
+        });
+    }
+
+#else
+
+    inline void clip_to_window(const vec4 *clip, std::size_t count, const viewport<float> &view, window_fixed *window, reciprocal division = reciprocal::refined)
+    {
+        GLA_INSTRUMENT_KERNEL("clip_to_window", count);
+
+        static_cast<void>(division);
+
+        const float scale_x = view.width / 2;
+        const float scale_y = view.height / 2;
+        const float scale_z = (view.far - view.near) / 2;
+
+        for (std::size_t i = 0; i < count; i++)
+        {
+            const vec4 &p = clip[i];
+
+            const float inverse_w = 1 / p.w;
+
+            window[i].x = detail::to_fixed_16_8(p.x * inverse_w * scale_x + view.x + scale_x);
+            window[i].y = detail::to_fixed_16_8(p.y * inverse_w * scale_y + view.y + scale_y);
+            window[i].z = p.z * inverse_w * scale_z + view.near + scale_z;
+            window[i].inverse_w = inverse_w;
+        }
+    }
+
+#endif
+}
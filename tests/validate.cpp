@@ -0,0 +1,13 @@
+#include <cstdlib>
+#include <iostream>
+
+#include "gla/validate.h"
+
+// validate [ samples [ seed ] ], fails when any kernel is out of its bound
+int main(int argc, char **argv)
+{
+    const std::size_t samples = (argc > 1) ? std::strtoull(argv[1], nullptr, 10) : 10000;
+    const std::uint64_t seed = (argc > 2) ? std::strtoull(argv[2], nullptr, 0) : 0x5EED;
+
+    return gla::validate::run_all(std::cout, samples, seed) ? EXIT_SUCCESS : EXIT_FAILURE;
+}